@@ -138,7 +138,7 @@ namespace AStarPrivate {
         }
     };
 
-    template<typename T, typename State, typename SeenType = Constexpr::SmallSet<T>, typename HistoryType = Constexpr::SmallMap<T, T>, typename ForcastType = Constexpr::SmallMap<T, State>>
+    template<typename T, typename State, typename SeenType = Constexpr::LookupSet<T>, typename HistoryType = Constexpr::LookupMap<T, T>, typename ForcastType = Constexpr::LookupMap<T, State>>
     constexpr std::vector<T> AStar(T start, auto costFunc, auto doneFunc, auto hFunc, auto nFunc, auto moveFunc) {       
         SeenType seen{};
         HistoryType cameFrom{};
@@ -380,9 +380,9 @@ constexpr std::vector<T> AStarMin(T start,
         return AStarPrivate::AStar<
             T,
             AStarPrivate::MinimalPath<T>,
-            Constexpr::SmallSet<T>,
-            Constexpr::SmallMap<T, T>,
-            Constexpr::SmallMap<T, AStarPrivate::MinimalPath<T>>
+            Constexpr::LookupSet<T>,
+            Constexpr::LookupMap<T, T>,
+            Constexpr::LookupMap<T, AStarPrivate::MinimalPath<T>>
         >(start, costFunc, doneFunc, hFunc, nFunc, moveFunc);
     }
 }
@@ -407,9 +407,9 @@ constexpr std::vector<T> AStarMin(T start, T end, auto nFunc) {
         return AStarPrivate::AStar<
             T,
             AStarPrivate::MinimalPath<T>,
-            Constexpr::SmallSet<T>,
-            Constexpr::SmallMap<T, T>,
-            Constexpr::SmallMap<T, AStarPrivate::MinimalPath<T>>
+            Constexpr::LookupSet<T>,
+            Constexpr::LookupMap<T, T>,
+            Constexpr::LookupMap<T, AStarPrivate::MinimalPath<T>>
         >(start, costFunc, doneFunc, hFunc, nFunc, moveFunc);
     }
 }
@@ -434,9 +434,9 @@ constexpr std::vector<T> AStarMax(T start,
         return AStarPrivate::AStar<
             T,
             AStarPrivate::MaximalPath<T>,
-            Constexpr::SmallSet<T>,
-            Constexpr::SmallMap<T, T>,
-            Constexpr::SmallMap<T, AStarPrivate::MaximalPath<T>>
+            Constexpr::LookupSet<T>,
+            Constexpr::LookupMap<T, T>,
+            Constexpr::LookupMap<T, AStarPrivate::MaximalPath<T>>
         >(start, costFunc, doneFunc, hFunc, nFunc, moveFunc);
     }
 }
@@ -461,9 +461,9 @@ constexpr std::vector<T> AStarMax(T start, T end, auto nFunc) {
         return AStarPrivate::AStar<
             T,
             AStarPrivate::MaximalPath<T>,
-            Constexpr::SmallSet<T>,
-            Constexpr::SmallMap<T, T>,
-            Constexpr::SmallMap<T, AStarPrivate::MaximalPath<T>>
+            Constexpr::LookupSet<T>,
+            Constexpr::LookupMap<T, T>,
+            Constexpr::LookupMap<T, AStarPrivate::MaximalPath<T>>
         >(start, costFunc, doneFunc, hFunc, nFunc, moveFunc);
     }
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
 //Returns all points filled
 template<typename T>
 constexpr std::vector<T> FloodFill(T start, auto NeighborFunc) {
-    Constexpr::SmallSet<T> seen{ start };
+    Constexpr::LookupSet<T> seen{ start };
     std::vector<T> q{ start };
     std::vector<T> result;
 
@@ -6,8 +6,19 @@
 #include <ranges>
 #include <algorithm>
 #include <iterator>
+#include <bit>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <optional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DR_SWISS_SSE2
+#endif
 
 #include "Core/Constexpr/ConstexprHash.h"
+#include "Core/Platform/Types.h"
 
 
 namespace Constexpr {
@@ -211,214 +222,403 @@ namespace Constexpr {
         return map.cend();
     }
 
-    template<typename Key, typename Value, size_t Capacity = 1'000'000, typename Hasher = Constexpr::Hasher<Key>>
-    struct BigMap {
-        constexpr BigMap() {
-            MakeSentinel();
-            mData = new std::array<std::pair<Key, Value>, Capacity>();
-            mData->fill(Sentinel);
-            mCurrentSize = 0;
+    namespace SwissDetail {
+        /*
+        Control bytes of the Swiss table: one per slot, either Empty, Deleted (a tombstone lookups
+        probe past) or Full with the low 7 bits of the key's hash (H2).  Lookups compare a group of 16
+        control bytes at once and only compare keys whose H2 matches.
+        */
+        constexpr u8 CtrlEmpty = 0x80;
+        constexpr u8 CtrlDeleted = 0xFE;
+        constexpr size_t GroupWidth = 16;
+
+        // Bit i is set if ctrl[i] == value
+        constexpr u32 MatchByte(const u8* ctrl, u8 value) {
+#ifdef DR_SWISS_SSE2
+            if (!std::is_constant_evaluated()) {
+                auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+                return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(value)))));
+            }
+#endif
+            u32 result = 0;
+            for (size_t i = 0; i < GroupWidth; i++) {
+                if (ctrl[i] == value) result |= 1u << i;
+            }
+            return result;
         }
 
-		constexpr BigMap(Key&& sentinel) : Sentinel(std::make_pair<Key, Value>(std::move(sentinel), {})) {
-			mData = new std::array<std::pair<Key, Value>, Capacity>();
-			mData->fill(Sentinel);
-			mCurrentSize = 0;
-		}
-
-        constexpr BigMap(const BigMap& other) : Sentinel(other.Sentinel), mCurrentSize(other.mCurrentSize) {
-            mData = new std::array<std::pair<Key, Value>, Capacity>();
-            *mData = *other.mData;
-        }
-        constexpr BigMap(BigMap&& other) : Sentinel(std::move(other.Sentinel)), mCurrentSize(other.mCurrentSize) {
-            mData = std::move(other.mData);
-            other.mData = nullptr;
-        }
-        constexpr BigMap(const std::initializer_list<std::pair<Key, Value>>& initialState) {
-            MakeSentinel();
-            mData = new std::array<std::pair<Key, Value>, Capacity>();
-            mData->fill(Sentinel);
-            for (const auto& p : initialState) {
-                (*mData)[FindSlot(p.first)] = p;
-                mCurrentSize++;
+        // Empty and Deleted are the only control bytes with the high bit set
+        constexpr u32 MatchEmptyOrDeleted(const u8* ctrl) {
+#ifdef DR_SWISS_SSE2
+            if (!std::is_constant_evaluated()) {
+                return static_cast<u32>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+            }
+#endif
+            u32 result = 0;
+            for (size_t i = 0; i < GroupWidth; i++) {
+                if (ctrl[i] & 0x80) result |= 1u << i;
             }
+            return result;
         }
 
-        constexpr ~BigMap() {
-            delete mData;
+        // Hashers may return the key itself (integers do), spread it over all the bits
+        constexpr u64 Mix(u64 hash) {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+            return hash;
         }
 
-        constexpr BigMap& operator=(const BigMap& other) {
-            *(this->mData) = (*other.mData);
-            Sentinel = other.Sentinel;
-            mCurrentSize = other.mCurrentSize;
-            return *this;
-        }
-        constexpr BigMap& operator=(BigMap&& other) {
-            if (this == &other) return *this;
-            mData = std::move(other.mData);
-            other.mData = nullptr;
+        constexpr u8 H2(u64 hash) { return static_cast<u8>(hash & 0x7F); }
+        constexpr u64 H1(u64 hash) { return hash >> 7; }
 
-            Sentinel = other.Sentinel;
-            mCurrentSize = other.mCurrentSize;
-            return *this;
-        }
+        /*
+        The table behind BigMap and BigSet.  Entries (the key, or a key value pair) are kept densely
+        in insertion order, erasing moves the last entry into the hole.  The control bytes and
+        mSlotEntry only index into them, so iterating, clearing and copying cost the number of
+        entries rather than the number of slots.  Nothing is allocated until the first insert.
+        Whether a slot is used lives only in its control byte, so every key value is valid, and the
+        hash of each entry is kept so growing and copying never hash a key again.
+        */
+        template<typename Key, typename Entry, typename Hasher>
+        class Table {
+        public:
+            static constexpr size_t NotFound = std::numeric_limits<size_t>::max();
+
+            constexpr Table() = default;
+            constexpr Table(const Table& other) : mEntries(other.mEntries), mEntryHash(other.mEntryHash), mHash(other.mHash) {
+                Reindex();
+            }
+            // The moved-from table is left empty (with no slots) so it can be reused
+            constexpr Table(Table&& other)
+                : mCtrl(std::exchange(other.mCtrl, {}))
+                , mSlotEntry(std::exchange(other.mSlotEntry, {}))
+                , mEntries(std::exchange(other.mEntries, {}))
+                , mEntryHash(std::exchange(other.mEntryHash, {}))
+                , mEntrySlot(std::exchange(other.mEntrySlot, {}))
+                , mGrowthLeft(std::exchange(other.mGrowthLeft, 0))
+                , mHash(std::move(other.mHash))
+            {}
+
+            constexpr Table& operator=(const Table& other) {
+                if (this == &other) return *this;
+                mEntries = other.mEntries;
+                mEntryHash = other.mEntryHash;
+                mHash = other.mHash;
+                Reindex();
+                return *this;
+            }
+            constexpr Table& operator=(Table&& other) {
+                if (this == &other) return *this;
+                mCtrl = std::exchange(other.mCtrl, {});
+                mSlotEntry = std::exchange(other.mSlotEntry, {});
+                mEntries = std::exchange(other.mEntries, {});
+                mEntryHash = std::exchange(other.mEntryHash, {});
+                mEntrySlot = std::exchange(other.mEntrySlot, {});
+                mGrowthLeft = std::exchange(other.mGrowthLeft, 0);
+                mHash = std::move(other.mHash);
+                return *this;
+            }
+
+            constexpr size_t size() const {
+                return mEntries.size();
+            }
 
-        constexpr void SetSentinel(Key newSentinel) {
-            for (auto& pair : *mData) {
-                if (pair == Sentinel) pair.first = newSentinel;
+            constexpr const std::vector<Entry>& Entries() const {
+                return mEntries;
+            }
+            constexpr Entry& operator[](size_t entry) {
+                return mEntries[entry];
+            }
+            constexpr const Entry& operator[](size_t entry) const {
+                return mEntries[entry];
+            }
+
+            // Index of the key's entry, or NotFound
+            constexpr size_t Find(const Key& key) const {
+                if (mCtrl.empty()) return NotFound;
+                auto slot = FindSlot(key, HashOf(key));
+                return slot == NotFound ? NotFound : mSlotEntry[slot];
+            }
+
+            // Index of the key's entry and whether it was added, makeEntry() is only called if it was
+            constexpr std::pair<size_t, bool> FindOrInsert(const Key& key, auto makeEntry) {
+                auto hash = HashOf(key);
+                if (!mCtrl.empty()) {
+                    auto slot = FindSlot(key, hash);
+                    if (slot != NotFound) return { mSlotEntry[slot], false };
+                }
+
+                if (mGrowthLeft == 0) {
+                    // Mostly tombstones: rehashing at the same size reclaims them
+                    Rehash(mCtrl.empty() ? GroupWidth : size() * 2 < MaxLoad(mCtrl.size()) ? mCtrl.size() : mCtrl.size() * 2);
+                }
+                auto slot = FindInsertSlot(hash);
+                if (mCtrl[slot] == CtrlEmpty) mGrowthLeft--;
+
+                auto entry = mEntries.size();
+                mEntries.push_back(makeEntry());
+                mEntryHash.push_back(hash);
+                mEntrySlot.push_back(static_cast<u32>(slot));
+                mCtrl[slot] = H2(hash);
+                mSlotEntry[slot] = static_cast<u32>(entry);
+                return { entry, true };
+            }
+
+            constexpr bool Erase(const Key& key) {
+                if (mCtrl.empty()) return false;
+                auto slot = FindSlot(key, HashOf(key));
+                if (slot == NotFound) return false;
+
+                // Lookups stop at a group with an empty slot, so only a tombstone keeps a full group
+                // from hiding keys which probed past it
+                auto groupStart = slot & ~(GroupWidth - 1);
+                if (MatchByte(&mCtrl[groupStart], CtrlEmpty) != 0) {
+                    mCtrl[slot] = CtrlEmpty;
+                    mGrowthLeft++;
+                }
+                else {
+                    mCtrl[slot] = CtrlDeleted;
+                }
+
+                auto entry = mSlotEntry[slot];
+                if (entry + 1 != mEntries.size()) {
+                    mEntries[entry] = std::move(mEntries.back());
+                    mEntryHash[entry] = mEntryHash.back();
+                    mEntrySlot[entry] = mEntrySlot.back();
+                    mSlotEntry[mEntrySlot[entry]] = entry;
+                }
+                mEntries.pop_back();
+                mEntryHash.pop_back();
+                mEntrySlot.pop_back();
+                return true;
+            }
+
+            // Only the slots of live entries are reset, tombstones stay until the next rehash
+            constexpr void Clear() {
+                for (auto slot : mEntrySlot) {
+                    mCtrl[slot] = CtrlEmpty;
+                }
+                mGrowthLeft += mEntries.size();
+                mEntries.clear();
+                mEntryHash.clear();
+                mEntrySlot.clear();
+            }
+
+        private:
+            // A power of two number of slots, in groups of GroupWidth.  Empty until the first insert.
+            std::vector<u8> mCtrl;
+            // Entry index of each full slot
+            std::vector<u32> mSlotEntry;
+            std::vector<Entry> mEntries;
+            // Mixed hash of each entry
+            std::vector<u64> mEntryHash;
+            // Slot of each entry
+            std::vector<u32> mEntrySlot;
+            // Inserts into empty (not deleted) slots left before rehashing
+            size_t mGrowthLeft{ 0 };
+            Hasher mHash{};
+
+            static constexpr size_t MaxLoad(size_t slots) {
+                return slots - slots / 8;
+            }
+
+            static constexpr const Key& KeyOf(const Entry& entry) {
+                if constexpr (std::is_same_v<Key, Entry>) {
+                    return entry;
+                }
+                else {
+                    return entry.first;
+                }
+            }
+
+            constexpr u64 HashOf(const Key& key) const {
+                return Mix(static_cast<u64>(mHash(key)));
+            }
+
+            // Visits the groups of the probe sequence (triangular, which reaches every group) until
+            // visit returns true
+            constexpr void Probe(u64 hash, auto visit) const {
+                const auto groupMask = mCtrl.size() / GroupWidth - 1;
+                auto group = H1(hash) & groupMask;
+                for (size_t step = 1; ; step++) {
+                    if (visit(group * GroupWidth)) return;
+                    group = (group + step) & groupMask;
+                }
+            }
+
+            constexpr size_t FindSlot(const Key& key, u64 hash) const {
+                auto h2 = H2(hash);
+                size_t result = NotFound;
+                Probe(hash, [&](size_t groupStart) {
+                    for (auto matches = MatchByte(&mCtrl[groupStart], h2); matches != 0; matches &= matches - 1) {
+                        auto slot = groupStart + static_cast<size_t>(std::countr_zero(matches));
+                        if (KeyOf(mEntries[mSlotEntry[slot]]) == key) {
+                            result = slot;
+                            return true;
+                        }
+                    }
+                    return MatchByte(&mCtrl[groupStart], CtrlEmpty) != 0;
+                });
+                return result;
+            }
+
+            // First empty or deleted slot along the key's probe sequence
+            constexpr size_t FindInsertSlot(u64 hash) const {
+                size_t result = NotFound;
+                Probe(hash, [&](size_t groupStart) {
+                    auto available = MatchEmptyOrDeleted(&mCtrl[groupStart]);
+                    if (available == 0) return false;
+                    result = groupStart + static_cast<size_t>(std::countr_zero(available));
+                    return true;
+                });
+                return result;
+            }
+
+            constexpr void Rehash(size_t slots) {
+                mCtrl.assign(slots, CtrlEmpty);
+                mSlotEntry.assign(slots, 0);
+                mGrowthLeft = MaxLoad(slots);
+                for (size_t entry = 0; entry < mEntries.size(); entry++) {
+                    auto hash = mEntryHash[entry];
+                    auto slot = FindInsertSlot(hash);
+                    mCtrl[slot] = H2(hash);
+                    mSlotEntry[slot] = static_cast<u32>(entry);
+                    mEntrySlot[entry] = static_cast<u32>(slot);
+                    mGrowthLeft--;
+                }
+            }
+
+            // Smallest table the entries fit in, or none at all
+            constexpr void Reindex() {
+                mEntrySlot.resize(mEntries.size());
+                if (mEntries.empty()) {
+                    mCtrl.clear();
+                    mSlotEntry.clear();
+                    mGrowthLeft = 0;
+                    return;
+                }
+
+                auto slots = GroupWidth;
+                while (MaxLoad(slots) <= mEntries.size()) slots *= 2;
+                Rehash(slots);
+            }
+        };
+    }
+
+    /*
+    Open addressing hash map (Swiss table).  Allocates on the first insert and doubles when 7/8 full.
+    Capacity is no longer allocated up front, it is kept so existing instantiations still compile.
+    Inserting or erasing invalidates references and iterators.
+    */
+    template<typename Key, typename Value, size_t Capacity = 1'000'000, typename Hasher = Constexpr::Hasher<Key>>
+    struct BigMap {
+        constexpr BigMap() = default;
+
+        constexpr BigMap(const std::initializer_list<std::pair<Key, Value>>& initialState) : BigMap() {
+            for (const auto& p : initialState) {
+                emplace(p.first, p.second);
             }
-            Sentinel.first = newSentinel;
         }
 
+        // Every key is usable now, the sentinel is ignored
+        [[deprecated("BigMap no longer needs a sentinel")]]
+        constexpr BigMap(Key&&) : BigMap() {}
+        [[deprecated("BigMap no longer needs a sentinel")]]
+        constexpr void SetSentinel(Key) {}
+
         constexpr void SetDefaultValue(Value val) {
             mDefaultValue = val;
         }
 
         constexpr Value& operator[](const Key& key) {
-            auto slot = FindSlot(key);
-            if (!IsOccupied(slot)) {
-                (*mData)[slot] = std::make_pair(key, mDefaultValue);
-                mCurrentSize++;
-            }
-            return (*mData)[slot].second;
+            auto [entry, inserted] = mTable.FindOrInsert(key, [&] { return std::make_pair(key, mDefaultValue); });
+            return mTable[entry].second;
         }
 
         constexpr void emplace(const Key& key, Value value) {
-            auto slot = FindSlot(key);
-            if (!IsOccupied(slot)) {
-                (*mData)[slot] = std::make_pair(key, value);
-                mCurrentSize++;
-            }
+            mTable.FindOrInsert(key, [&] { return std::make_pair(key, std::move(value)); });
         }
 
         constexpr Value& at(const Key& key) {
-            auto slot = FindSlot(key);
-            if (!IsOccupied(slot)) throw "Key not found";
-            return (*mData)[slot].second;
+            auto entry = mTable.Find(key);
+            if (entry == Table::NotFound) throw "Key not found";
+            return mTable[entry].second;
         }
 
         constexpr const Value& at(const Key& key) const {
-            auto slot = FindSlot(key);
-            if (!IsOccupied(slot)) {
+            auto entry = mTable.Find(key);
+            if (entry == Table::NotFound) {
                 throw "Key not found";
             }
-            return (*mData)[slot].second;
+            return mTable[entry].second;
         }
 
         constexpr bool is_empty() const {
             return size() == 0;
         }
         constexpr size_t size() const {
-            return mCurrentSize;
+            return mTable.size();
         }
 
         constexpr void clear() {
-            mData->fill(Sentinel);
-            mCurrentSize = 0;
+            mTable.Clear();
         }
         constexpr bool contains(const Key& key) const {
-            return IsOccupied(FindSlot(key));
+            return mTable.Find(key) != Table::NotFound;
         }
         constexpr size_t erase(const Key& key) {
-            auto slot = FindSlot(key);
-            if (!IsOccupied(slot)) return 0ull;
-            (*mData)[slot] = Sentinel;
-            mCurrentSize--;
-            for (size_t j = (slot + 1) % Capacity; j != slot; j = (j + 1) % Capacity) {
-                if (!IsOccupied(j)) return 1ull;
-                size_t k = FindSlot((*mData)[j].first);
-                if (slot <= j) {
-                    if ((slot < k) && (k <= j)) {
-                        continue;
-                    }
-                }
-                else {
-                    if ((slot < k) || (k <= j)) {
-                        continue;
-                    }
-                }
-
-                (*mData)[slot] = (*mData)[j];
-                (*mData)[j] = Sentinel;
-                slot = j;
-            }
-            //maybe warn that the map is full?
-            return 1ull;
+            return mTable.Erase(key) ? 1ull : 0ull;
         }
 
-        /*
-        constexpr auto begin() {
-            return mData->begin();
-        }
         constexpr auto begin() const {
-            return mData->begin();
+            return mTable.Entries().begin();
         }
         constexpr auto cbegin() const {
-            return mData->cbegin();
-        }
-        constexpr auto end() {
-            return mData->end();
+            return mTable.Entries().cbegin();
         }
         constexpr auto end() const {
-            return mData->end();
+            return mTable.Entries().end();
         }
         constexpr auto cend() const {
-            return mData->cend();
+            return mTable.Entries().cend();
         }
-        */
 
         constexpr std::vector<Key> GetKeys() const {
-            return *mData
-				| std::views::filter([this](const auto& p) { return p != Sentinel; })
-				| std::views::transform([](const auto& p) { return p.first; })
-				| std::ranges::to<std::vector>();
+            return mTable.Entries() | std::views::keys | std::ranges::to<std::vector>();
         }
 
         constexpr std::vector<Value> GetValues() const {
-            return *mData
-				| std::views::filter([this](const auto& p) { return p != Sentinel; })
-				| std::views::transform([](const auto& p) { return p.second; })
-				| std::ranges::to<std::vector>();
+            return mTable.Entries() | std::views::values | std::ranges::to<std::vector>();
         }
 
         constexpr std::vector<std::pair<Key, Value>> GetAllEntries() const {
-            return *mData
-				| std::views::filter([this](const auto& p) { return p != Sentinel; })
-				| std::ranges::to<std::vector>();
+            return mTable.Entries();
         }
     private:
-        std::array<std::pair<Key, Value>, Capacity>* mData{};
-        std::pair<Key, Value> Sentinel;
-        size_t mCurrentSize{ 0 };
-        Hasher mHash{};
-        Value mDefaultValue{};
-
-        constexpr void MakeSentinel() {
-            if constexpr (std::is_same_v<std::remove_cvref_t<Key>, std::string>) {
-                Sentinel = std::make_pair<Key, Value>("SentinelString", {});
-            }
-            else if constexpr (std::is_arithmetic_v<Key>) {
-                Sentinel = std::make_pair<Key, Value>(Key(9919), {});
-            }
-            else {
-                Sentinel = std::make_pair<Key, Value>({}, {}); //bleh
-            }
-        }
-
-        constexpr size_t FindSlot(const Key& key) const {
-            size_t i = mHash(key) % Capacity;
-            while ((*mData)[i].first != Sentinel.first && (*mData)[i].first != key) {
-                i = (i + 1) % Capacity;
-            }
-            return i;
-        };
+        using Table = SwissDetail::Table<Key, std::pair<Key, Value>, Hasher>;
 
-        constexpr bool IsOccupied(size_t slot) const {
-            return (*mData)[slot].first != Sentinel.first;
-        }
+        Table mTable;
+        Value mDefaultValue{};
     };
 
+    template<typename Key, typename Value, size_t Capacity, typename Hasher>
+    constexpr inline auto begin(BigMap<Key, Value, Capacity, Hasher>& map) {
+        return map.begin();
+    }
+    template<typename Key, typename Value, size_t Capacity, typename Hasher>
+    constexpr inline auto cbegin(const BigMap<Key, Value, Capacity, Hasher>& map) {
+        return map.cbegin();
+    }
+    template<typename Key, typename Value, size_t Capacity, typename Hasher>
+    constexpr inline auto end(BigMap<Key, Value, Capacity, Hasher>& map) {
+        return map.end();
+    }
+    template<typename Key, typename Value, size_t Capacity, typename Hasher>
+    constexpr inline auto cend(const BigMap<Key, Value, Capacity, Hasher>& map) {
+        return map.cend();
+    }
+
     template<typename T>
     class Stack {
     public:
@@ -469,49 +669,140 @@ namespace Constexpr {
         std::vector<T> mData;
     };
 
+    /*
+    FIFO queue in a ring buffer which doubles when full, so push and pop are O(1).  The buffer is a
+    power of two so wrapping is a mask.  Slots are optional so T needn't be default constructible,
+    popped slots are emptied so they don't hold on to resources (e.g. string buffers).
+    */
     template<typename T>
     class Queue {
     public:
         constexpr Queue() = default;
-        constexpr Queue(const Queue& other) : mData(other.mData) {}
-        constexpr Queue(Queue&& other) : mData(std::move(other.mData)) {}
-        constexpr Queue(T initial) : mData(initial) {}
+        constexpr Queue(const Queue& other) : mData(other.mData), mHead(other.mHead), mSize(other.mSize) {}
+        constexpr Queue(Queue&& other) noexcept
+            : mData(std::move(other.mData))
+            , mHead(std::exchange(other.mHead, 0))
+            , mSize(std::exchange(other.mSize, 0))
+        {
+            other.mData.clear();
+        }
+        constexpr Queue(T initial) {
+            push(std::move(initial));
+        }
 
-        Queue& operator=(const Queue& other) {
+        constexpr Queue& operator=(const Queue& other) {
             mData = other.mData;
+            mHead = other.mHead;
+            mSize = other.mSize;
             return *this;
         }
-        Queue& operator=(Queue&& other) {
-            mData = other.mData;
+        constexpr Queue& operator=(Queue&& other) noexcept {
+            if (this == &other) return *this;
+            mData = std::move(other.mData);
+            mHead = std::exchange(other.mHead, 0);
+            mSize = std::exchange(other.mSize, 0);
+            other.mData.clear();
             return *this;
         }
+
         constexpr void push(const T& val) {
-            mData.push_back(val);
+            if (mSize == mData.size()) {
+                // val may live in this queue, copy it before growing frees the buffer
+                push(T(val));
+                return;
+            }
+            mData[Index(mSize)].emplace(val);
+            mSize++;
+        }
+        constexpr void push(T&& val) {
+            if (mSize == mData.size()) {
+                T moved(std::move(val));
+                Reserve(mSize + 1);
+                mData[Index(mSize)].emplace(std::move(moved));
+            }
+            else {
+                mData[Index(mSize)].emplace(std::move(val));
+            }
+            mSize++;
+        }
+
+        // Grows at most once for sized ranges
+        template<std::ranges::input_range R>
+        constexpr void push_range(R&& values) {
+            if constexpr (std::ranges::sized_range<R>) {
+                Reserve(mSize + static_cast<size_t>(std::ranges::size(values)));
+            }
+            for (auto&& val : values) {
+                push(std::forward<decltype(val)>(val));
+            }
         }
+
         constexpr T front() const {
-            if (mData.empty()) {
+            if (mSize == 0) {
                 throw "Accessing empty queue";
             }
-            return mData[0];
+            return *mData[mHead];
         }
         constexpr void pop() {
-            if (mData.empty()) {
+            if (mSize == 0) {
                 throw "Popping empty queue";
             }
-            mData.erase(mData.begin());
+            mData[mHead].reset();
+            mHead = Index(1);
+            mSize--;
+        }
+
+        // Removes and returns the first count elements, oldest first
+        constexpr std::vector<T> pop_range(size_t count) {
+            if (count > mSize) {
+                throw "Popping more than the queue holds";
+            }
+            std::vector<T> result;
+            result.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                auto& slot = mData[Index(i)];
+                result.push_back(std::move(*slot));
+                slot.reset();
+            }
+            mHead = Index(count);
+            mSize -= count;
+            return result;
         }
+
         constexpr bool is_empty() const {
-            return mData.empty();
+            return mSize == 0;
         }
         constexpr void clear() {
-            mData.clear();
+            for (size_t i = 0; i < mSize; i++) {
+                mData[Index(i)].reset();
+            }
+            mHead = 0;
+            mSize = 0;
         }
         constexpr std::size_t size() const {
-            return mData.size();
+            return mSize;
         }
 
     private:
-        std::vector<T> mData;
+        // Power of two (or empty), the elements are mData[mHead] onwards, wrapping around
+        std::vector<std::optional<T>> mData;
+        size_t mHead{ 0 };
+        size_t mSize{ 0 };
+
+        constexpr size_t Index(size_t offset) const {
+            return (mHead + offset) & (mData.size() - 1);
+        }
+
+        constexpr void Reserve(size_t count) {
+            if (count <= mData.size()) return;
+
+            std::vector<std::optional<T>> data(std::bit_ceil(std::max(count, size_t(8))));
+            for (size_t i = 0; i < mSize; i++) {
+                data[i] = std::move(mData[Index(i)]);
+            }
+            mData = std::move(data);
+            mHead = 0;
+        }
     };
 
     template<typename T>
@@ -573,6 +864,9 @@ namespace Constexpr {
     };
 
 
+    template<typename T>
+    concept Ordered = requires (T a) { a < a; };
+
     template<typename T>
     class SmallSet {
     public:
@@ -591,9 +885,11 @@ namespace Constexpr {
         }
 
         constexpr bool insert(const T& val) {
-            if (mData.size() >= mNextSort) {
-                std::sort(mData.begin(), mData.end());
-                mNextSort *= 4;
+            if constexpr (Ordered<T>) {
+                if (mData.size() >= mNextSort) {
+                    std::sort(mData.begin(), mData.end());
+                    mNextSort *= 4;
+                }
             }
             if (contains(val)) {
                 return false;
@@ -675,67 +971,27 @@ namespace Constexpr {
         return set.cend();
     }
 
+    /*
+    Open addressing hash set, the same table as BigMap.  Capacity is no longer allocated up front, it
+    is kept so existing instantiations still compile.
+    */
     template<typename T, size_t Capacity = 1'000'000, typename Hasher = Constexpr::Hasher<T>>
     class BigSet {
     public:
-        constexpr BigSet() {
-            MakeSentinel();
-            mData = new std::array<T, Capacity>();
-            mData->fill(Sentinel);
-        }
-		constexpr explicit BigSet(T&& sentinel) : Sentinel(std::move(sentinel)) {
-			mData = new std::array<T, Capacity>();
-			mData->fill(Sentinel);
-		}
-        constexpr BigSet(const BigSet& other) : Sentinel(other.Sentinel), mCurrentSize(other.mCurrentSize) {
-            mData = new std::array<T, Capacity>();
-            *mData = *other.mData;
-        }
+        constexpr BigSet() = default;
 
-        constexpr BigSet(BigSet&& other) : Sentinel(other.Sentinel), mCurrentSize(other.mCurrentSize) {
-            mData = std::move(other.mData);
-            other.mData = nullptr;
+        constexpr BigSet(const std::initializer_list<T>& initial) {
+            insert(initial.begin(), initial.end());
         }
 
-        constexpr BigSet(const std::initializer_list<T>& initial) { 
-            MakeSentinel();
-            mData = new std::array<T, Capacity>();
-            mData->fill(Sentinel);
+        // Every value is usable now, the sentinel is ignored
+        [[deprecated("BigSet no longer needs a sentinel")]]
+        constexpr explicit BigSet(T&&) : BigSet() {}
+        [[deprecated("BigSet no longer needs a sentinel")]]
+        constexpr void SetSentinel(T) {}
 
-            for (const auto& e : initial) {
-                insert(e);
-            }
-        }
-        constexpr ~BigSet() { delete mData; }
-
-        constexpr BigSet& operator=(const BigSet& other) {
-            *(this->mData) = *(other.mData);
-            Sentinel = other.Sentinel;
-            mCurrentSize = other.mCurrentSize;
-            return *this;
-        }
-        constexpr BigSet& operator=(BigSet&& other) {
-            if (this == &other) return *this;
-            this->mData = std::move(other.mData);
-            other.mData = nullptr;
-
-            Sentinel = other.Sentinel;
-            mCurrentSize = other.mCurrentSize;
-            return *this;
-        }
-
-        constexpr void SetSentinel(T newSentinel) {
-            for (auto& s : *mData) {
-                if (s == Sentinel) s = newSentinel;
-            }
-            Sentinel = newSentinel;
-        }
         constexpr bool insert(const T& val) {
-            auto slot = FindSlot(val);
-            if (IsOccupied(slot)) return false; //either full, or already in set
-            (*mData)[slot] = val;
-            mCurrentSize++;
-            return true;
+            return mTable.FindOrInsert(val, [&] { return val; }).second;
         }
 
         constexpr void insert(const auto& begin, const auto& end) {
@@ -745,109 +1001,44 @@ namespace Constexpr {
         }
 
         constexpr bool contains(const T& val) const {
-            return IsOccupied(FindSlot(val));
+            return mTable.Find(val) != Table::NotFound;
         }
 
         constexpr void erase(const T& val) {
-            auto slot = FindSlot(val);
-            if (!IsOccupied(slot)) return;
-            (*mData)[slot] = Sentinel;
-            mCurrentSize--;
-            for (size_t j = (slot + 1) % Capacity; j != slot; j = (j + 1) % Capacity) {
-                if (!IsOccupied(j)) return;
-                size_t k = FindSlot((*mData)[j]);
-                if (slot <= j) {
-                    if ((slot < k) && (k <= j)) {
-                        continue;
-                    }
-                }
-                else {
-                    if ((slot < k) || (k <= j)) {
-                        continue;
-                    }
-                }
-
-                (*mData)[slot] = (*mData)[j];
-                (*mData)[j] = Sentinel;
-                slot = j;
-            }
-            return;
+            mTable.Erase(val);
         }
 
         constexpr bool empty() const {
-            return mCurrentSize == 0;
+            return mTable.size() == 0;
         }
         constexpr void clear() {
-            mData->fill(Sentinel);
-            mCurrentSize = 0;
+            mTable.Clear();
         }
         constexpr std::size_t size() const {
-            return mCurrentSize;
+            return mTable.size();
         }
 
         constexpr std::vector<T> GetValues() const {
-            std::vector<T> result;
-            std::copy_if(mData->begin(), mData->end(), std::back_inserter(result), [&](const T& val) {
-                return val != Sentinel;
-                });
-            return result;
+            return mTable.Entries();
         }
 
-        //TODO: Yeah, these don't work
-        /*
-        constexpr auto begin() {
-            return mData.begin();
-        }
         constexpr auto begin() const {
-            return mData.begin();
+            return mTable.Entries().begin();
         }
         constexpr auto cbegin() const {
-            return mData.cbegin();
-        }
-        constexpr auto end() {
-            return mData.end();
+            return mTable.Entries().cbegin();
         }
         constexpr auto end() const {
-            return mData.end();
+            return mTable.Entries().end();
         }
         constexpr auto cend() const {
-            return mData.cend();
+            return mTable.Entries().cend();
         }
-        */
 
     private:
-        T Sentinel{};
-        std::array<T, Capacity>* mData;
-        size_t mCurrentSize = 0;
-        Hasher mHash{};
-
-        constexpr void MakeSentinel() {
-            if constexpr (std::is_same_v<std::remove_cvref_t<T>, std::string>) {
-                Sentinel = "SentinelString";
-            }
-            else if constexpr (std::is_arithmetic_v<T>) {
-                Sentinel = 9919;
-            }
-            else {
-                Sentinel = {}; //bleh
-            }
-        }
-        
-
-        constexpr size_t FindSlot(const T& t) const {
-            if (mCurrentSize == Capacity) throw "SetFull";
-
-            //size_t i = Constexpr::Hash(t) % Capacity;
-            size_t i = mHash(t) % Capacity;
-            while ((*mData)[i] != Sentinel && (*mData)[i] != t) {
-                i = (i + 1) % Capacity;
-            }
-            return i;
-        };
+        using Table = SwissDetail::Table<T, T, Hasher>;
 
-        constexpr bool IsOccupied(size_t slot) const {
-            return (*mData)[slot] != Sentinel;
-        }
+        Table mTable;
     };
 
     template<typename T, size_t Capacity>
@@ -867,6 +1058,264 @@ namespace Constexpr {
         return set.cend();
     }
 
+    namespace FlatDetail {
+        constexpr size_t LinearSearchMax = 32;
+
+        // Calling the unspecialized Hasher doesn't compile, keys without one keep the collection flat
+        template<typename Hasher>
+        constexpr bool CanHash = !requires { typename Hasher::Unimplemented; };
+
+        // Stands in for a missing Hasher so the (never used) table still compiles
+        struct NoHasher {
+            constexpr size_t operator()(const auto&) const { return 0; }
+        };
+
+        template<typename Hasher>
+        using TableHasher = std::conditional_t<CanHash<Hasher>, Hasher, NoHasher>;
+
+        // Index of the first key not less than key.  Small arrays are counted without branches, which
+        // the compiler turns into SIMD compares for arithmetic keys, larger ones are binary searched.
+        template<typename Key>
+        constexpr size_t LowerBound(const std::vector<Key>& keys, const Key& key) {
+            if (keys.size() <= LinearSearchMax) {
+                size_t result = 0;
+                for (const auto& k : keys) {
+                    result += k < key ? 1 : 0;
+                }
+                return result;
+            }
+            return static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        }
+    }
+
+    /*
+    Map with its keys in a sorted array (and the values in a parallel one) for binary search.
+    Once it holds more than PromoteAt entries, it moves everything into the same hash table as
+    BigMap, if Key has a Hasher, and stays hashed from then on.  Keys need operator<.
+    */
+    template<typename Key, typename Value, size_t PromoteAt = 64, typename Hasher = Constexpr::Hasher<Key>>
+    class FlatMap {
+    public:
+        constexpr FlatMap() = default;
+        constexpr FlatMap(const std::initializer_list<std::pair<Key, Value>>& initialState) {
+            for (const auto& [key, value] : initialState) {
+                operator[](key) = value;
+            }
+        }
+
+        constexpr Value& operator[](const Key& key) {
+            if (mHashed) {
+                auto [entry, inserted] = mTable.FindOrInsert(key, [&] { return std::make_pair(key, Value{}); });
+                return mTable[entry].second;
+            }
+
+            auto index = FlatDetail::LowerBound(mKeys, key);
+            if (index < mKeys.size() && !(key < mKeys[index])) return mValues[index];
+
+            if (CanPromote && mKeys.size() >= PromoteAt) {
+                Promote();
+                return operator[](key);
+            }
+            mKeys.insert(mKeys.begin() + index, key);
+            return *mValues.insert(mValues.begin() + index, Value{});
+        }
+
+        constexpr Value& at(const Key& key) {
+            return const_cast<Value&>(std::as_const(*this).at(key));
+        }
+
+        constexpr const Value& at(const Key& key) const {
+            if (mHashed) {
+                auto entry = mTable.Find(key);
+                if (entry == Table::NotFound) throw "Key not found";
+                return mTable[entry].second;
+            }
+
+            auto index = Find(key);
+            if (index == mKeys.size()) throw "Key not found";
+            return mValues[index];
+        }
+
+        constexpr bool is_empty() const {
+            return size() == 0;
+        }
+        constexpr size_t size() const {
+            return mHashed ? mTable.size() : mKeys.size();
+        }
+
+        constexpr void clear() {
+            mKeys.clear();
+            mValues.clear();
+            mTable.Clear();
+        }
+        constexpr bool contains(const Key& key) const {
+            if (mHashed) return mTable.Find(key) != Table::NotFound;
+            return Find(key) != mKeys.size();
+        }
+        constexpr size_t erase(const Key& key) {
+            if (mHashed) return mTable.Erase(key) ? 1ull : 0ull;
+
+            auto index = Find(key);
+            if (index == mKeys.size()) return 0ull;
+            mKeys.erase(mKeys.begin() + index);
+            mValues.erase(mValues.begin() + index);
+            return 1ull;
+        }
+
+        // Sorted while the map is flat
+        constexpr std::vector<Key> GetKeys() const {
+            if (mHashed) return mTable.Entries() | std::views::keys | std::ranges::to<std::vector>();
+            return mKeys;
+        }
+
+        constexpr std::vector<Value> GetValues() const {
+            if (mHashed) return mTable.Entries() | std::views::values | std::ranges::to<std::vector>();
+            return mValues;
+        }
+
+        constexpr std::vector<std::pair<Key, Value>> GetAllEntries() const {
+            if (mHashed) return mTable.Entries();
+
+            std::vector<std::pair<Key, Value>> result;
+            result.reserve(mKeys.size());
+            for (size_t i = 0; i < mKeys.size(); i++) {
+                result.emplace_back(mKeys[i], mValues[i]);
+            }
+            return result;
+        }
+
+    private:
+        using Table = SwissDetail::Table<Key, std::pair<Key, Value>, FlatDetail::TableHasher<Hasher>>;
+
+        static constexpr bool CanPromote = FlatDetail::CanHash<Hasher>;
+
+        std::vector<Key> mKeys;
+        std::vector<Value> mValues;
+        Table mTable;
+        bool mHashed{ false };
+
+        // Index of key, or mKeys.size()
+        constexpr size_t Find(const Key& key) const {
+            auto index = FlatDetail::LowerBound(mKeys, key);
+            return index < mKeys.size() && !(key < mKeys[index]) ? index : mKeys.size();
+        }
+
+        constexpr void Promote() {
+            for (size_t i = 0; i < mKeys.size(); i++) {
+                mTable.FindOrInsert(mKeys[i], [&] { return std::make_pair(mKeys[i], std::move(mValues[i])); });
+            }
+            mKeys = {};
+            mValues = {};
+            mHashed = true;
+        }
+    };
+
+    /*
+    Set kept as a sorted array for binary search, which moves into the same hash table as BigSet
+    once it holds more than PromoteAt values (if T has a Hasher).  Values need operator<.
+    */
+    template<typename T, size_t PromoteAt = 64, typename Hasher = Constexpr::Hasher<T>>
+    class FlatSet {
+    public:
+        constexpr FlatSet() = default;
+        constexpr FlatSet(const std::initializer_list<T>& initial) {
+            insert(initial.begin(), initial.end());
+        }
+
+        constexpr bool insert(const T& val) {
+            if (mHashed) return mTable.FindOrInsert(val, [&] { return val; }).second;
+
+            auto index = FlatDetail::LowerBound(mValues, val);
+            if (index < mValues.size() && !(val < mValues[index])) return false;
+
+            if (CanPromote && mValues.size() >= PromoteAt) {
+                Promote();
+                return insert(val);
+            }
+            mValues.insert(mValues.begin() + index, val);
+            return true;
+        }
+
+        constexpr void insert(const auto& begin, const auto& end) {
+            for (auto it = begin; it != end; it++) {
+                insert(*it);
+            }
+        }
+
+        constexpr bool contains(const T& val) const {
+            if (mHashed) return mTable.Find(val) != Table::NotFound;
+
+            auto index = FlatDetail::LowerBound(mValues, val);
+            return index < mValues.size() && !(val < mValues[index]);
+        }
+
+        constexpr void erase(const T& val) {
+            if (mHashed) {
+                mTable.Erase(val);
+                return;
+            }
+
+            auto index = FlatDetail::LowerBound(mValues, val);
+            if (index < mValues.size() && !(val < mValues[index])) {
+                mValues.erase(mValues.begin() + index);
+            }
+        }
+
+        constexpr bool empty() const {
+            return size() == 0;
+        }
+        constexpr void clear() {
+            mValues.clear();
+            mTable.Clear();
+        }
+        constexpr std::size_t size() const {
+            return mHashed ? mTable.size() : mValues.size();
+        }
+
+        // In order while the set is flat
+        constexpr auto begin() const {
+            return mHashed ? mTable.Entries().begin() : mValues.begin();
+        }
+        constexpr auto cbegin() const {
+            return begin();
+        }
+        constexpr auto end() const {
+            return mHashed ? mTable.Entries().end() : mValues.end();
+        }
+        constexpr auto cend() const {
+            return end();
+        }
+
+    private:
+        using Table = SwissDetail::Table<T, T, FlatDetail::TableHasher<Hasher>>;
+
+        static constexpr bool CanPromote = FlatDetail::CanHash<Hasher>;
+
+        std::vector<T> mValues;
+        Table mTable;
+        bool mHashed{ false };
+
+        constexpr void Promote() {
+            for (const auto& val : mValues) {
+                mTable.FindOrInsert(val, [&] { return val; });
+            }
+            mValues = {};
+            mHashed = true;
+        }
+    };
+
+    // FlatSet/FlatMap for keys with operator<, otherwise BigSet/BigMap if the key has a Hasher, and
+    // the linear SmallSet/SmallMap (which only need operator==) as a last resort
+    template<typename T>
+    using LookupSet = std::conditional_t<Ordered<T>,
+        FlatSet<T>,
+        std::conditional_t<FlatDetail::CanHash<Hasher<T>>, BigSet<T>, SmallSet<T>>>;
+
+    template<typename Key, typename Value>
+    using LookupMap = std::conditional_t<Ordered<Key>,
+        FlatMap<Key, Value>,
+        std::conditional_t<FlatDetail::CanHash<Hasher<Key>>, BigMap<Key, Value>, SmallMap<Key, Value>>>;
+
     template<typename T, size_t Capacity = 1024>
     struct Ring {
         constexpr void push_front(T val) {
@@ -73,6 +73,9 @@ namespace Constexpr {
 
     template<typename T>
     struct Hasher {
+        // Only the unspecialized template has this, so collections can tell if a type is hashable
+        using Unimplemented = void;
+
         constexpr size_t operator()(const T&) const {
             static_assert(std::_Always_false<T>, "Hash not implemented for type");
             return 0;
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Thread safe PubSub.  Publish reads an immutable snapshot of the subscribers (a contiguous vector)
+without taking a lock, Subscribe/Unsubscribe copy the snapshot, modify the copy and swap it in
+(read-copy-update), so writers never block publishers.
+
+Once Unsubscribe returns the subscriber will not be called again: it waits for publishes which
+are still using an older snapshot to finish.  When called from inside a callback of the same
+PubSub, the publish on the current thread is not waited for (it would never finish), so that
+publish may still reach the unsubscribed callback.
+*/
+template<typename TEvent>
+struct ConcurrentPubSub {
+	using Callback = std::function<void(const TEvent&)>;
+
+	ConcurrentPubSub() = default;
+	ConcurrentPubSub(const ConcurrentPubSub&) = delete;
+	ConcurrentPubSub& operator=(const ConcurrentPubSub&) = delete;
+
+	size_t Subscribe(Callback subscriber) {
+		std::lock_guard lock(m_WriteMutex);
+		auto handle = m_NextHandle++;
+		Update([&](Subscribers& subscribers) {
+			subscribers.push_back({ handle, std::move(subscriber), nullptr });
+		});
+		return handle;
+	}
+
+	// Called on the next publish only
+	void Alarm(Callback onAlarm) {
+		std::lock_guard lock(m_WriteMutex);
+		auto handle = m_NextHandle++;
+		Update([&](Subscribers& subscribers) {
+			subscribers.push_back({ handle, std::move(onAlarm), std::make_shared<std::atomic<bool>>(false) });
+		});
+	}
+
+	void Unsubscribe(size_t handle) {
+		std::vector<Retired> retired;
+		{
+			std::lock_guard lock(m_WriteMutex);
+			if (!Remove(handle)) return;
+			retired = m_Retired;
+		}
+		WaitForReaders(retired);
+	}
+
+	void Publish(const TEvent& event) {
+		auto snapshot = m_Subscribers.load(std::memory_order_acquire);
+		if (!snapshot || snapshot->empty()) return;
+
+		PublishScope scope(this, snapshot.get());
+		bool firedAlarm = false;
+		for (const auto& subscriber : *snapshot) {
+			if (subscriber.Fired) {
+				if (subscriber.Fired->exchange(true, std::memory_order_acq_rel)) continue;
+				firedAlarm = true;
+			}
+			subscriber.OnEvent(event);
+		}
+
+		if (firedAlarm) {
+			std::lock_guard lock(m_WriteMutex);
+			Update([](Subscribers& subscribers) {
+				std::erase_if(subscribers, [](const Subscriber& subscriber) {
+					return subscriber.Fired && subscriber.Fired->load(std::memory_order_acquire);
+				});
+			});
+		}
+	}
+
+	size_t SubscriberCount() const {
+		auto snapshot = m_Subscribers.load(std::memory_order_acquire);
+		return snapshot ? snapshot->size() : 0;
+	}
+
+private:
+	struct Subscriber {
+		size_t Handle;
+		Callback OnEvent;
+		// Only set for alarms, shared between snapshots so an alarm fires once
+		std::shared_ptr<std::atomic<bool>> Fired;
+	};
+	using Subscribers = std::vector<Subscriber>;
+
+	// Tracks the snapshots the current thread is publishing from, so Unsubscribe called from a
+	// callback doesn't wait on itself
+	struct PublishScope {
+		PublishScope(const ConcurrentPubSub* owner, const Subscribers* snapshot) {
+			Active().push_back({ owner, snapshot });
+		}
+		~PublishScope() {
+			Active().pop_back();
+		}
+
+		static size_t HeldBy(const ConcurrentPubSub* owner, const Subscribers* snapshot) {
+			return static_cast<size_t>(std::ranges::count_if(Active(), [&](const auto& scope) {
+				return scope.first == owner && scope.second == snapshot;
+			}));
+		}
+
+	private:
+		static std::vector<std::pair<const ConcurrentPubSub*, const Subscribers*>>& Active() {
+			thread_local std::vector<std::pair<const ConcurrentPubSub*, const Subscribers*>> active{};
+			return active;
+		}
+	};
+
+	// Snapshots which have been replaced but may still be in use by publishers
+	struct Retired {
+		std::weak_ptr<const Subscribers> Snapshot;
+		const Subscribers* Address;
+	};
+
+	// Must hold m_WriteMutex
+	template<typename Func>
+	void Update(Func func) {
+		auto current = m_Subscribers.load(std::memory_order_acquire);
+		auto next = current ? std::make_shared<Subscribers>(*current) : std::make_shared<Subscribers>();
+		func(*next);
+		m_Subscribers.store(std::move(next), std::memory_order_release);
+
+		if (current) {
+			std::erase_if(m_Retired, [](const Retired& retired) { return retired.Snapshot.expired(); });
+			m_Retired.push_back({ current, current.get() });
+		}
+	}
+
+	// Must hold m_WriteMutex, returns false if the handle was not found
+	bool Remove(size_t handle) {
+		auto current = m_Subscribers.load(std::memory_order_acquire);
+		auto matches = [&](const Subscriber& subscriber) { return subscriber.Handle == handle; };
+		if (!current || std::ranges::none_of(*current, matches)) {
+			return false;
+		}
+		Update([&](Subscribers& subscribers) { std::erase_if(subscribers, matches); });
+		return true;
+	}
+
+	// Grace period: every publisher which loaded an older snapshot holds a reference to it,
+	// wait for those references to go away (except the ones held further up this thread's stack)
+	void WaitForReaders(const std::vector<Retired>& retired) {
+		for (const auto& old : retired) {
+			auto allowed = PublishScope::HeldBy(this, old.Address);
+			while (static_cast<size_t>(old.Snapshot.use_count()) > allowed) {
+				std::this_thread::yield();
+			}
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+	}
+
+	std::atomic<std::shared_ptr<const Subscribers>> m_Subscribers{};
+	std::mutex m_WriteMutex;
+	std::vector<Retired> m_Retired{};
+	size_t m_NextHandle{ 0 };
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "Core/Platform/Types.h"
+
+namespace Benchmark {
+	// Size in bytes of the largest (last level) CPU cache, or a conservative guess if it can't be queried
+	size_t LastLevelCacheSize();
+
+	/*
+	Pre-generated argument sets which Runner::RunRotating cycles through, one per call.
+	With enough data behind the arguments (more than the last level cache) every call starts
+	with cold caches like it would in production, instead of reusing the same hot inputs.
+	*/
+	template<typename... Args>
+	class ArgumentPool {
+	public:
+		explicit ArgumentPool(std::vector<std::tuple<Args...>> sets)
+			: m_Sets(std::move(sets))
+		{
+			if (m_Sets.empty()) throw "Argument pool must not be empty";
+		}
+
+		// generate(index) returns a std::tuple<Args...>, called count times
+		template<typename Generator>
+		static ArgumentPool Generate(size_t count, Generator generate) {
+			std::vector<std::tuple<Args...>> sets;
+			sets.reserve(count);
+			for (size_t i = 0; i < count; i++) {
+				sets.push_back(generate(i));
+			}
+			return ArgumentPool(std::move(sets));
+		}
+
+		// Generates enough sets for their data to be twice the last level cache, bytesPerSet is
+		// the memory each set touches (including what it points to)
+		template<typename Generator>
+		static ArgumentPool ExceedingCache(size_t bytesPerSet, Generator generate) {
+			auto count = (2 * LastLevelCacheSize() + bytesPerSet - 1) / std::max<size_t>(bytesPerSet, 1);
+			return Generate(std::max<size_t>(count, 1), generate);
+		}
+
+		const std::tuple<Args...>& Next() {
+			const auto& result = m_Sets[m_Index];
+			if (++m_Index == m_Sets.size()) m_Index = 0;
+			return result;
+		}
+
+		size_t Size() const { return m_Sets.size(); }
+
+	private:
+		std::vector<std::tuple<Args...>> m_Sets;
+		size_t m_Index{ 0 };
+	};
+}
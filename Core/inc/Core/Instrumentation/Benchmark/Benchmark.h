@@ -1,37 +1,82 @@
 #pragma once
+#include <algorithm>
+#include <barrier>
 #include <chrono>
+#include <optional>
+#include <random>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
 
 #include "Core/Instrumentation/Benchmark/Stats.h"
 #include "Core/Instrumentation/Benchmark/ResourceMonitor.h"
+#include "Core/Instrumentation/Benchmark/PerfCounters.h"
+#include "Core/Instrumentation/Benchmark/Compare.h"
+#include "Core/Instrumentation/Benchmark/ArgumentPool.h"
+#include "Core/Instrumentation/Benchmark/Scaling.h"
+#include "Core/Instrumentation/Benchmark/DoNotOptimize.h"
 
 namespace Benchmark {
 	using namespace std::chrono_literals;
 
-	enum struct RuntimeResolution { Micros, Millis, Seconds	};
+	enum struct RuntimeResolution { Nanos, Micros, Millis, Seconds };
 	constexpr std::string ToUnit(RuntimeResolution res) {
 		switch (res) {
+		case RuntimeResolution::Nanos: return "ns";
 		case RuntimeResolution::Micros: return "us";
 		case RuntimeResolution::Millis: return "ms";
 		case RuntimeResolution::Seconds: return "s";
 		}
 		return "Unknown";
 	}
+	// Runtimes are measured in nanoseconds
 	constexpr f64 ToFactor(RuntimeResolution res) {
 		switch (res) {
-		case RuntimeResolution::Micros: return 1.0;
-		case RuntimeResolution::Millis: return 1 / 1'000.0;
-		case RuntimeResolution::Seconds: return 1 / 1'000'000.0;
+		case RuntimeResolution::Nanos: return 1.0;
+		case RuntimeResolution::Micros: return 1 / 1'000.0;
+		case RuntimeResolution::Millis: return 1 / 1'000'000.0;
+		case RuntimeResolution::Seconds: return 1 / 1'000'000'000.0;
 		}
 		return 1.0;
 	}
 
+	namespace Detail {
+		// void functions still produce a Result, with an empty ReturnValue
+		template<typename TResult>
+		using StoredReturn = std::conditional_t<std::is_void_v<TResult>, std::monostate, TResult>;
+	}
+
 	template<typename TResult>
 	struct Result {
 		Stats RuntimeStats;
-		TResult ReturnValue;
+		// From the last timed call
+		Detail::StoredReturn<TResult> ReturnValue;
 		std::unordered_map<MonitorType, Stats> MonitorStats;
+		// Per iteration counts, only for the requested counters which were available
+		std::unordered_map<PerfCounter, Stats> CounterStats;
+		// Per iteration instructions per cycle, when both counters were available
+		std::optional<Stats> Ipc;
+
+		// Per iteration runtime of each timed batch (in RuntimeStats' unit), reservoir sampled down to MaxSamples
+		std::vector<f64> Samples;
+		// Timed calls, not including warmup
+		u64 Iterations{ 0 };
+		// Calls per timestamp, chosen during warmup so a batch takes at least MinBatchDuration
+		u64 BatchSize{ 1 };
+		// Samples outside Tukey's fences (1.5 IQR beyond the quartiles), still included in RuntimeStats
+		size_t LowOutliers{ 0 };
+		size_t HighOutliers{ 0 };
 	};
 
+	// Both results should use the same RuntimeResolution
+	template<typename TBaseline, typename TCandidate>
+	Comparison Compare(const Result<TBaseline>& baseline, const Result<TCandidate>& candidate, f64 confidence = 0.95) {
+		return Compare(std::span<const f64>(baseline.Samples), std::span<const f64>(candidate.Samples), confidence);
+	}
+
 	struct MonitorConfig {
 		MonitorType Type;
 		std::chrono::milliseconds Interval;
@@ -39,20 +84,278 @@ namespace Benchmark {
 		std::string Label;
 	};
 
+	namespace Detail {
+		// Keeps a uniform random subset of at most Capacity values
+		class Reservoir {
+		public:
+			explicit Reservoir(size_t capacity) : m_Capacity(capacity) {}
+
+			void Add(f64 value) {
+				m_Seen++;
+				if (m_Values.size() < m_Capacity) {
+					m_Values.push_back(value);
+					return;
+				}
+				auto index = std::uniform_int_distribution<u64>(0, m_Seen - 1)(m_Random);
+				if (index < m_Capacity) m_Values[index] = value;
+			}
+
+			std::vector<f64>& Values() { return m_Values; }
+
+		private:
+			size_t m_Capacity;
+			u64 m_Seen{ 0 };
+			std::vector<f64> m_Values;
+			std::mt19937_64 m_Random{ 0 };
+		};
+
+		// Returns the { low, high } outlier counts
+		inline std::pair<size_t, size_t> CountOutliers(std::vector<f64> values) {
+			if (values.size() < 4) return { 0, 0 };
+			std::sort(values.begin(), values.end());
+			auto q1 = values[values.size() / 4];
+			auto q3 = values[values.size() * 3 / 4];
+			auto fence = 1.5 * (q3 - q1);
+			auto low = static_cast<size_t>(std::lower_bound(values.begin(), values.end(), q1 - fence) - values.begin());
+			auto high = static_cast<size_t>(values.end() - std::upper_bound(values.begin(), values.end(), q3 + fence));
+			return { low, high };
+		}
+	}
+
 	class Runner {
 		friend class Builder;
 		std::chrono::milliseconds m_MaxDuration{};
+		std::chrono::milliseconds m_WarmupDuration{};
+		std::chrono::nanoseconds m_MinBatchDuration{};
 		std::vector<MonitorConfig> m_MonitorConfigs;
+		std::vector<PerfCounter> m_PerfCounters;
 		u32 m_MaxIterations{};
+		size_t m_MaxSamples{};
 		RuntimeResolution m_RuntimeResolution{ RuntimeResolution::Micros };
+		bool m_PinThreads{ false };
 		Runner() = default;
 	public:
+		// Calls func with the same arguments every time
 		template<typename Func, typename... Args>
-		Result<std::invoke_result_t<Func, Args...>> Run(Func func, Args... args) {
-			using Ret = std::invoke_result_t<Func, Args...>;
+		Result<std::remove_cvref_t<std::invoke_result_t<Func&, Args&...>>> Run(Func func, Args... args) const {
+			auto invoke = [&]() -> decltype(auto) { return func(args...); };
+			return RunImpl(invoke);
+		}
+
+		// Each call takes the next argument set from the pool, so the inputs aren't already in cache
+		template<typename Func, typename... Args>
+		Result<std::remove_cvref_t<std::invoke_result_t<Func&, const Args&...>>> RunRotating(Func func, ArgumentPool<Args...>& pool) const {
+			auto invoke = [&]() -> decltype(auto) { return std::apply(func, pool.Next()); };
+			return RunImpl(invoke);
+		}
+
+		// Warms up both, then alternates timed batches of the baseline and the candidate (so drift
+		// such as frequency scaling affects both alike) and compares their samples.  Each gets up to
+		// MaxIterations calls, the whole measurement takes up to twice MaxDuration.
+		template<typename BaselineFunc, typename CandidateFunc, typename... Args>
+		Comparison Compare(BaselineFunc baseline, CandidateFunc candidate, Args... args) const {
+			using clock = std::chrono::steady_clock;
+
+			auto timeBaseline = [&](u64 calls) { return TimeCalls([&]() -> decltype(auto) { return baseline(args...); }, calls); };
+			auto timeCandidate = [&](u64 calls) { return TimeCalls([&]() -> decltype(auto) { return candidate(args...); }, calls); };
+			auto baselineBatch = Calibrate(timeBaseline, clock::now() + m_WarmupDuration);
+			auto candidateBatch = Calibrate(timeCandidate, clock::now() + m_WarmupDuration);
+
+			const auto factor = ToFactor(m_RuntimeResolution);
+			Detail::Reservoir baselineSamples(m_MaxSamples);
+			Detail::Reservoir candidateSamples(m_MaxSamples);
+			u64 baselineIterations = 0;
+			u64 candidateIterations = 0;
+			auto sample = [&](auto& timeBatch, u64 batchSize, u64& iterations, Detail::Reservoir& samples) {
+				auto calls = std::min<u64>(batchSize, m_MaxIterations - iterations);
+				auto elapsed = timeBatch(calls);
+				samples.Add(static_cast<f64>(elapsed.count()) / static_cast<f64>(calls) * factor);
+				iterations += calls;
+			};
+
+			auto end = clock::now() + 2 * m_MaxDuration;
+			while (baselineIterations < m_MaxIterations && candidateIterations < m_MaxIterations && clock::now() < end) {
+				sample(timeBaseline, baselineBatch, baselineIterations, baselineSamples);
+				sample(timeCandidate, candidateBatch, candidateIterations, candidateSamples);
+			}
+			return Benchmark::Compare(std::span<const f64>(baselineSamples.Values()), std::span<const f64>(candidateSamples.Values()));
+		}
+
+		// Calls func concurrently from each number of threads, the threads warm up then start measuring
+		// together.  func may take the thread's index (0 to threads - 1) to use per thread state.
+		// Monitors and perf counters only apply to Run.
+		template<typename Func>
+		std::vector<ScalingPoint> RunScaling(Func func, const std::vector<u32>& threadCounts) const {
+			std::vector<ScalingPoint> result;
+			for (auto threads : threadCounts) {
+				if (threads == 0) throw "Thread count must be positive";
+				result.push_back(RunThreads(func, threads));
+
+				const auto& first = result.front();
+				auto& point = result.back();
+				point.Efficiency = first.Throughput > 0.0
+					? (point.Throughput / point.Threads) / (first.Throughput / first.Threads)
+					: 0.0;
+			}
+			return result;
+		}
+
+	private:
+		// Times the given number of back to back calls, every result goes through DoNotOptimize
+		template<typename Invoke>
+		static std::chrono::nanoseconds TimeCalls(Invoke&& invoke, u64 calls) {
+			auto start = std::chrono::steady_clock::now();
+			for (u64 call = 0; call < calls; call++) {
+				if constexpr (std::is_void_v<std::invoke_result_t<Invoke&>>) invoke();
+				else DoNotOptimize(invoke());
+				ClobberMemory();
+			}
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		}
+
+		// Warmup, which also doubles the batch size until a batch is long enough that the
+		// clock's resolution and overhead don't matter.  Returns the batch size.
+		template<typename TimeBatch>
+		u64 Calibrate(TimeBatch& timeBatch, std::chrono::steady_clock::time_point warmupEnd) const {
+			u64 batchSize = 1;
+			while (true) {
+				auto elapsed = timeBatch(batchSize);
+				bool calibrated = elapsed >= m_MinBatchDuration || batchSize >= m_MaxIterations;
+				if (!calibrated) {
+					batchSize = std::min<u64>(batchSize * 2, m_MaxIterations);
+				}
+				else if (std::chrono::steady_clock::now() >= warmupEnd) {
+					return batchSize;
+				}
+			}
+		}
+
+		template<typename Func>
+		ScalingPoint RunThreads(Func& func, u32 threads) const {
+			using clock = std::chrono::steady_clock;
+
+			std::vector<Histogram> latencies(threads);
+			std::vector<u64> iterations(threads);
+			std::vector<clock::time_point> finished(threads);
+
+			// The last thread to arrive sets the deadlines, so no thread starts a phase early
+			clock::time_point warmupEnd, start, end;
+			u32 phase = 0;
+			auto onPhase = [&]() noexcept {
+				auto now = clock::now();
+				if (phase++ == 0) {
+					warmupEnd = now + m_WarmupDuration;
+				}
+				else {
+					start = now;
+					end = now + m_MaxDuration;
+				}
+			};
+			std::barrier sync(threads, onPhase);
+
+			auto worker = [&](u32 index) {
+				if (m_PinThreads) PinCurrentThread(index % std::max(1u, std::thread::hardware_concurrency()));
+
+				auto timeBatch = [&](u64 calls) {
+					auto batchStart = clock::now();
+					for (u64 call = 0; call < calls; call++) {
+						if constexpr (std::is_invocable_v<Func&, u32>) {
+							if constexpr (std::is_void_v<std::invoke_result_t<Func&, u32>>) func(index);
+							else DoNotOptimize(func(index));
+						}
+						else {
+							if constexpr (std::is_void_v<std::invoke_result_t<Func&>>) func();
+							else DoNotOptimize(func());
+						}
+						ClobberMemory();
+					}
+					return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - batchStart);
+				};
+
+				sync.arrive_and_wait();
+				auto batchSize = Calibrate(timeBatch, warmupEnd);
+				sync.arrive_and_wait();
+
+				// Local until the end, neighbouring elements of the shared vectors would falsely share cache lines
+				Histogram latency;
+				u64 iteration = 0;
+				while (iteration < m_MaxIterations && clock::now() < end) {
+					auto calls = std::min<u64>(batchSize, m_MaxIterations - iteration);
+					auto elapsed = timeBatch(calls);
+					latency.Add(static_cast<f64>(elapsed.count()) / static_cast<f64>(calls));
+					iteration += calls;
+				}
+				finished[index] = clock::now();
+				iterations[index] = iteration;
+				latencies[index] = std::move(latency);
+			};
+
+			{
+				std::vector<std::jthread> workers;
+				workers.reserve(threads);
+				for (u32 i = 0; i < threads; i++) {
+					workers.emplace_back(worker, i);
+				}
+			}
+
+			const auto factor = ToFactor(m_RuntimeResolution);
+			const auto unit = ToUnit(m_RuntimeResolution);
+			ScalingPoint point;
+			point.Threads = threads;
+			Histogram combined;
+			for (u32 i = 0; i < threads; i++) {
+				combined.Merge(latencies[i]);
+				auto stats = Stats(latencies[i], unit);
+				stats *= factor;
+				point.ThreadLatency.push_back(stats);
+				point.Iterations += iterations[i];
+			}
+			point.Latency = Stats(combined, unit);
+			point.Latency *= factor;
+
+			auto elapsed = std::chrono::duration<f64>(*std::max_element(finished.begin(), finished.end()) - start);
+			point.Throughput = elapsed.count() > 0.0 ? static_cast<f64>(point.Iterations) / elapsed.count() : 0.0;
+			return point;
+		}
+
+		template<typename Invoke>
+		Result<std::remove_cvref_t<std::invoke_result_t<Invoke&>>> RunImpl(Invoke& invoke) const {
+			using Ret = std::remove_cvref_t<std::invoke_result_t<Invoke&>>;
 			using namespace std::chrono_literals;
+			using clock = std::chrono::steady_clock;
 
-			StatHolder runtimeStats;
+			// Every result goes through DoNotOptimize so the calls can't be elided or hoisted.
+			// The last one is kept (outside of the timing) for Result::ReturnValue.
+			std::optional<Detail::StoredReturn<Ret>> resultValue;
+			auto timeBatch = [&](u64 calls) {
+				auto start = clock::now();
+				if constexpr (std::is_void_v<Ret>) {
+					for (u64 call = 0; call < calls; call++) {
+						invoke();
+						ClobberMemory();
+					}
+					auto elapsed = clock::now() - start;
+					resultValue.emplace();
+					return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+				}
+				else {
+					for (u64 call = 1; call < calls; call++) {
+						Ret value = invoke();
+						DoNotOptimize(value);
+					}
+					Ret value = invoke();
+					DoNotOptimize(value);
+					auto elapsed = clock::now() - start;
+					resultValue.emplace(std::move(value));
+					return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+				}
+			};
+
+			auto batchSize = Calibrate(timeBatch, clock::now() + m_WarmupDuration);
+
+			// Histograms keep memory and record cost fixed no matter how many iterations run
+			Histogram runtimeStats;
+			Detail::Reservoir samples(m_MaxSamples);
 			std::vector<StatHolder> monitorStats;
 			std::vector<std::unique_ptr<ResourceMonitor>> monitors;
 			monitorStats.reserve(m_MonitorConfigs.size());
@@ -63,37 +366,81 @@ namespace Benchmark {
 				monitors.emplace_back(std::make_unique<ResourceMonitor>(config.Type, config.Interval, monitorStats.back()));
 			}
 
-			using clock = std::chrono::high_resolution_clock;
-			auto start = clock::now();
-			auto end = start + m_MaxDuration;
-			u32 iteration = 0;
-			Ret resultValue{};
+			std::optional<PerfCounters> counters;
+			std::vector<Histogram> counterStats;
+			Histogram ipcStats;
+			std::vector<u64> countersBefore, countersAfter;
+			if (!m_PerfCounters.empty()) {
+				counters.emplace(m_PerfCounters);
+				counterStats.resize(counters->GetAvailable().size());
+				countersBefore.resize(counterStats.size());
+				countersAfter.resize(counterStats.size());
+			}
+			const std::vector<PerfCounter> noCounters;
+			const auto& available = counters ? counters->GetAvailable() : noCounters;
+			auto indexOf = [&](PerfCounter counter) {
+				return static_cast<size_t>(std::find(available.begin(), available.end(), counter) - available.begin());
+			};
+			const auto cyclesIndex = indexOf(PerfCounter::Cycles);
+			const auto instructionsIndex = indexOf(PerfCounter::Instructions);
+			const bool recordIpc = counters && cyclesIndex < counterStats.size() && instructionsIndex < counterStats.size();
+
+			const auto factor = ToFactor(m_RuntimeResolution);
+			auto end = clock::now() + m_MaxDuration;
+			u64 iteration = 0;
 			{
 				for (auto& monitor : monitors) {
 					monitor->Start();
 				}
+				if (counters) counters->Start();
 				while (iteration < m_MaxIterations && clock::now() < end) {
-					start = clock::now();
-					resultValue = func(args...);
-					auto micros = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
-					runtimeStats.Add(static_cast<f64>(micros));
-					iteration++;
+					auto calls = std::min<u64>(batchSize, m_MaxIterations - iteration);
+					if (counters) counters->Read(countersBefore);
+					auto elapsed = timeBatch(calls);
+					if (counters) counters->Read(countersAfter);
+
+					auto perCall = static_cast<f64>(elapsed.count()) / static_cast<f64>(calls);
+					runtimeStats.Add(perCall);
+					samples.Add(perCall * factor);
+
+					for (size_t i = 0u; i < counterStats.size(); i++) {
+						counterStats[i].Add(static_cast<f64>(countersAfter[i] - countersBefore[i]) / static_cast<f64>(calls));
+					}
+					if (recordIpc) {
+						auto cycles = countersAfter[cyclesIndex] - countersBefore[cyclesIndex];
+						auto instructions = countersAfter[instructionsIndex] - countersBefore[instructionsIndex];
+						if (cycles > 0) ipcStats.Add(static_cast<f64>(instructions) / static_cast<f64>(cycles));
+					}
+					iteration += calls;
 				}
+				if (counters) counters->Stop();
 			}
 
 			Result<Ret> result{
-				.RuntimeStats = runtimeStats.GetStats(ToUnit(m_RuntimeResolution)),
-				.ReturnValue = resultValue,
-				.MonitorStats = {}
+				.RuntimeStats = Stats(runtimeStats, ToUnit(m_RuntimeResolution)),
+				.ReturnValue = std::move(*resultValue),
+				.MonitorStats = {},
+				.CounterStats = {},
+				.Ipc = std::nullopt,
+				.Samples = std::move(samples.Values()),
+				.Iterations = iteration,
+				.BatchSize = batchSize
 			};
 
-			result.RuntimeStats *= ToFactor(m_RuntimeResolution);
+			result.RuntimeStats *= factor;
+			std::tie(result.LowOutliers, result.HighOutliers) = Detail::CountOutliers(result.Samples);
 			for (size_t i = 0u; i < m_MonitorConfigs.size(); i++) {
 				const auto& config = m_MonitorConfigs[i];
 				auto stats = monitorStats[i].GetStats(config.Label);
 				stats *= config.Factor;
 				result.MonitorStats.insert({ config.Type, stats });
 			}
+			for (size_t i = 0u; i < counterStats.size(); i++) {
+				result.CounterStats.insert({ available[i], Stats(counterStats[i]) });
+			}
+			if (recordIpc) {
+				result.Ipc = Stats(ipcStats);
+			}
 			return result;
 		}
 	};
@@ -114,25 +461,68 @@ namespace Benchmark {
 			return *this;
 		}
 
+		// Untimed calls before measuring, to fill caches and let the branch predictor and CPU clock settle
+		template<typename Rep, typename Period>
+		Builder& WithWarmup(std::chrono::duration<Rep, Period> duration) {
+			m_WarmupDuration = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+			return *this;
+		}
+
+		// Functions faster than this are called in batches, each sample is the batch's mean
+		template<typename Rep, typename Period>
+		Builder& WithMinBatchDuration(std::chrono::duration<Rep, Period> duration) {
+			m_MinBatchDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+			return *this;
+		}
+
+		// Upper bound of Result::Samples
+		Builder& WithMaxSamples(size_t samples) {
+			m_MaxSamples = samples;
+			return *this;
+		}
+
 		Builder& WithMonitor(MonitorConfig config) {
 			m_MonitorConfigs.emplace_back(config);
 			return *this;
 		}
 
+		// Counters which can't be opened (e.g. in a container) are left out of Result::CounterStats
+		Builder& WithPerfCounters(std::vector<PerfCounter> counters) {
+			m_PerfCounters = std::move(counters);
+			return *this;
+		}
+
+		// RunScaling pins thread i to logical cpu i (wrapping around), so the scheduler can't move
+		// threads around mid measurement.  Leave off when the threads outnumber the cores.
+		Builder& WithThreadPinning(bool pin = true) {
+			m_PinThreads = pin;
+			return *this;
+		}
+
 		Runner Build() {
 			Runner runner;
 			runner.m_MaxDuration = m_MaxDuration;
+			runner.m_WarmupDuration = m_WarmupDuration;
+			runner.m_MinBatchDuration = m_MinBatchDuration;
 			runner.m_MaxIterations = m_MaxIterations;
+			runner.m_MaxSamples = m_MaxSamples;
 			runner.m_MonitorConfigs = m_MonitorConfigs;
+			runner.m_PerfCounters = m_PerfCounters;
 			runner.m_RuntimeResolution = m_RuntimeResolution;
+			runner.m_PinThreads = m_PinThreads;
 			return runner;
 		}
 	
 	private:
 		std::chrono::milliseconds m_MaxDuration{ 5min };
+		std::chrono::milliseconds m_WarmupDuration{ 100ms };
+		std::chrono::nanoseconds m_MinBatchDuration{ 10us };
 		u32 m_MaxIterations{ 1'000'000 };
+		size_t m_MaxSamples{ 10'000 };
 		std::vector<MonitorConfig> m_MonitorConfigs;
+		std::vector<PerfCounter> m_PerfCounters;
 		RuntimeResolution m_RuntimeResolution{ RuntimeResolution::Micros };
+		bool m_PinThreads{ false };
 	};
 	/*
 	class Benchmark {
@@ -0,0 +1,31 @@
+#pragma once
+#include <span>
+#include <string>
+
+#include "Core/Platform/Types.h"
+
+namespace Benchmark {
+	struct Comparison {
+		// Baseline median / candidate median, above 1 means the candidate is faster
+		f64 Speedup{ 1.0 };
+		// Bootstrap confidence interval of the speedup
+		f64 SpeedupLow{ 1.0 };
+		f64 SpeedupHigh{ 1.0 };
+		// Two sided Mann-Whitney U test, the chance of a difference this large when both come from the same distribution
+		f64 PValue{ 1.0 };
+		f64 Confidence{ 0.95 };
+		f64 BaselineMedian{ 0.0 };
+		f64 CandidateMedian{ 0.0 };
+
+		constexpr bool IsSignificant() const {
+			return PValue < 1.0 - Confidence;
+		}
+	};
+
+	// Compares two sets of per-iteration runtimes (e.g. Result::Samples).  Resampling is seeded,
+	// so the same samples always give the same interval.
+	Comparison Compare(std::span<const f64> baseline, std::span<const f64> candidate, f64 confidence = 0.95, u32 resamples = 1000);
+
+	// e.g. "1.52x faster [1.47x, 1.58x] (p = 0.0001)"
+	std::string ToString(const Comparison& comparison);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+Optimization barriers for benchmarks.
+
+DoNotOptimize(value) makes the compiler assume the value is read (and for non-const values, modified)
+by something it can't see, so the computation producing it can't be removed or hoisted out of the loop.
+ClobberMemory() makes it assume all memory was read and written, forcing pending stores to happen.
+*/
+namespace Benchmark {
+#ifdef _MSC_VER
+	namespace Detail {
+		// Defined out of line so the optimizer can't see it does nothing
+		void UseCharPointer(const volatile char*);
+	}
+
+	template<typename T>
+	inline void DoNotOptimize(const T& value) {
+		Detail::UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+		_ReadWriteBarrier();
+	}
+
+	inline void ClobberMemory() {
+		_ReadWriteBarrier();
+	}
+#else
+	template<typename T>
+	inline void DoNotOptimize(const T& value) {
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	template<typename T>
+	inline void DoNotOptimize(T& value) {
+		// Small trivially copyable values may stay in a register, anything else must be in memory
+		if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*)) {
+			asm volatile("" : "+m,r"(value) : : "memory");
+		}
+		else {
+			asm volatile("" : "+m"(value) : : "memory");
+		}
+	}
+
+	inline void ClobberMemory() {
+		asm volatile("" : : : "memory");
+	}
+#endif
+}
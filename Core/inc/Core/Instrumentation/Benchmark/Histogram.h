@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Core/Platform/Types.h"
+#include "Core/Constexpr/ConstexprMath.h"
+
+/*
+Log-linear (HDR style) histogram of f64 samples.  Every power of two between Lowest and Highest
+is split into 2^PrecisionBits equal buckets, so a bucket's width is at most 2^-PrecisionBits
+of its value and recording is a bit_cast, a shift and an increment.  Memory is fixed by the
+range and precision (the defaults use ~50KB) no matter how many samples are recorded.
+
+Values below Lowest (including 0 and negatives) share an underflow bucket and values above Highest
+are counted in the last bucket.  Count, Min, Max, Mean and StdDev are tracked exactly, percentiles
+are accurate to half a bucket.
+
+Not thread safe, record into one histogram per thread and Merge them.
+*/
+class Histogram {
+public:
+	static constexpr u32 DefaultPrecisionBits = 7;
+	static constexpr f64 DefaultLowest = 1.0 / (1 << 10);
+	static constexpr f64 DefaultHighest = static_cast<f64>(1ull << 40);
+
+	constexpr explicit Histogram(u32 precisionBits = DefaultPrecisionBits, f64 lowest = DefaultLowest, f64 highest = DefaultHighest)
+		: m_PrecisionBits(precisionBits)
+		, m_Lowest(lowest)
+		, m_Highest(highest)
+	{
+		if (precisionBits < 1 || precisionBits > 20) throw "Histogram precision must be between 1 and 20 bits";
+		if (!(lowest >= std::numeric_limits<f64>::min()) || !(highest > lowest) || std::isinf(highest)) throw "Invalid histogram range";
+
+		m_FirstKey = Key(lowest);
+		m_Counts.resize(static_cast<size_t>(Key(highest) - m_FirstKey) + 2);
+	}
+
+	constexpr void Add(f64 value) {
+		Add(value, 1);
+	}
+
+	constexpr void Add(f64 value, u64 count) {
+		if (std::isnan(value) || count == 0) return;
+
+		m_Counts[IndexOf(value)] += count;
+		m_Min = std::min(m_Min, value);
+		m_Max = std::max(m_Max, value);
+
+		// Welford's update, kept in the form which merges
+		auto previousCount = static_cast<f64>(m_Count);
+		m_Count += count;
+		auto delta = value - m_Mean;
+		m_Mean += delta * static_cast<f64>(count) / static_cast<f64>(m_Count);
+		m_M2 += delta * delta * previousCount * static_cast<f64>(count) / static_cast<f64>(m_Count);
+	}
+
+	// Both histograms must have been created with the same precision and range
+	constexpr void Merge(const Histogram& other) {
+		if (m_PrecisionBits != other.m_PrecisionBits || m_Lowest != other.m_Lowest || m_Highest != other.m_Highest) {
+			throw "Can only merge histograms with the same layout";
+		}
+		if (other.m_Count == 0) return;
+
+		for (size_t i = 0; i < m_Counts.size(); i++) {
+			m_Counts[i] += other.m_Counts[i];
+		}
+		m_Min = std::min(m_Min, other.m_Min);
+		m_Max = std::max(m_Max, other.m_Max);
+
+		auto count = static_cast<f64>(m_Count);
+		auto otherCount = static_cast<f64>(other.m_Count);
+		auto total = count + otherCount;
+		auto delta = other.m_Mean - m_Mean;
+		m_Mean += delta * otherCount / total;
+		m_M2 += other.m_M2 + delta * delta * count * otherCount / total;
+		m_Count += other.m_Count;
+	}
+
+	constexpr void Reset() {
+		std::fill(m_Counts.begin(), m_Counts.end(), 0ull);
+		m_Count = 0;
+		m_Min = std::numeric_limits<f64>::infinity();
+		m_Max = -std::numeric_limits<f64>::infinity();
+		m_Mean = 0.0;
+		m_M2 = 0.0;
+	}
+
+	// percent is in [0, 100], so Percentile(99.9) is p99.9.  Returns 0 when empty.
+	constexpr f64 Percentile(f64 percent) const {
+		if (m_Count == 0) return 0.0;
+		if (percent <= 0.0) return m_Min;
+		if (percent >= 100.0) return m_Max;
+
+		auto rank = static_cast<u64>(std::ceil(percent / 100.0 * static_cast<f64>(m_Count)));
+		rank = std::clamp(rank, u64(1), m_Count);
+
+		u64 seen = 0;
+		for (size_t i = 0; i < m_Counts.size(); i++) {
+			seen += m_Counts[i];
+			if (seen >= rank) {
+				return std::clamp(BucketValue(i), m_Min, m_Max);
+			}
+		}
+		return m_Max;
+	}
+
+	constexpr u64 Count() const { return m_Count; }
+	constexpr f64 Min() const { return m_Count == 0 ? 0.0 : m_Min; }
+	constexpr f64 Max() const { return m_Count == 0 ? 0.0 : m_Max; }
+	constexpr f64 Mean() const { return m_Mean; }
+	constexpr f64 StdDev() const {
+		return m_Count == 0 ? 0.0 : Constexpr::Sqrt(m_M2 / static_cast<f64>(m_Count));
+	}
+
+	constexpr size_t BucketCount() const { return m_Counts.size(); }
+
+private:
+	// The exponent and top mantissa bits of a positive double increase monotonically with its value
+	constexpr u64 Key(f64 value) const {
+		return std::bit_cast<u64>(value) >> (52 - m_PrecisionBits);
+	}
+
+	constexpr size_t IndexOf(f64 value) const {
+		if (!(value >= m_Lowest)) return 0;
+		if (value >= m_Highest) return m_Counts.size() - 1;
+		return static_cast<size_t>(Key(value) - m_FirstKey) + 1;
+	}
+
+	constexpr f64 BucketValue(size_t index) const {
+		if (index == 0) return m_Min;
+		auto key = m_FirstKey + index - 1;
+		auto lower = std::bit_cast<f64>(key << (52 - m_PrecisionBits));
+		auto upper = std::bit_cast<f64>((key + 1) << (52 - m_PrecisionBits));
+		return lower + (upper - lower) / 2.0;
+	}
+
+	u32 m_PrecisionBits;
+	f64 m_Lowest;
+	f64 m_Highest;
+	u64 m_FirstKey{ 0 };
+	std::vector<u64> m_Counts;
+
+	u64 m_Count{ 0 };
+	f64 m_Min{ std::numeric_limits<f64>::infinity() };
+	f64 m_Max{ -std::numeric_limits<f64>::infinity() };
+	f64 m_Mean{ 0.0 };
+	f64 m_M2{ 0.0 };
+};
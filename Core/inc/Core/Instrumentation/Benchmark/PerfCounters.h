@@ -0,0 +1,54 @@
+#pragma once
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Core/Platform/Types.h"
+
+enum struct PerfCounter { Cycles, Instructions, CacheMisses, BranchMisses, ContextSwitches };
+constexpr std::string ToString(PerfCounter counter) {
+	switch (counter) {
+	case PerfCounter::Cycles: return "Cycles";
+	case PerfCounter::Instructions: return "Instructions";
+	case PerfCounter::CacheMisses: return "Cache Misses";
+	case PerfCounter::BranchMisses: return "Branch Misses";
+	case PerfCounter::ContextSwitches: return "Context Switches";
+	}
+	return "Unknown";
+}
+
+namespace PerfImpl {
+	struct EventGroup;
+}
+
+/*
+Hardware and software event counters for the calling thread (perf_event_open on Linux).
+The counters are opened as a single group so they are scheduled together and can be read
+with one syscall, cheap enough to read around every benchmark iteration.
+
+Opening never throws, counters which the kernel refuses (no PMU in a VM, perf_event_paranoid,
+seccomp in a container, other platforms) are simply missing from GetAvailable().
+*/
+class PerfCounters {
+public:
+	explicit PerfCounters(const std::vector<PerfCounter>& counters);
+	~PerfCounters();
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	// The requested counters which could be opened, in request order
+	const std::vector<PerfCounter>& GetAvailable() const;
+	bool IsAvailable(PerfCounter counter) const;
+
+	// Resets and enables the counters
+	void Start();
+	void Stop();
+
+	// Totals since Start, one per available counter (in GetAvailable order)
+	void Read(std::span<u64> outValues) const;
+
+private:
+	std::unique_ptr<PerfImpl::EventGroup> m_Group;
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include <functional>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "Core/Instrumentation/Benchmark/Report.h"
+
+/*
+How to use:
+	DR_BENCHMARK(Split) {
+		return Benchmark::MakeReport(runner.Run([]() { return StrUtil::Split("a,b,c", ","); }));
+	}
+
+	// Registered once per value as BigMapInsert/8, BigMapInsert/64, ... BigMapInsert/4096
+	DR_BENCHMARK(BigMapInsert, Benchmark::Range(8, 4096)) {
+		auto keys = MakeKeys(arg);
+		return Benchmark::MakeReport(runner.Run([&]() { ... }));
+	}
+
+	// One run over every thread count, reported as PublishThreads/1, PublishThreads/2, ... so each
+	// report's efficiency is relative to the 1 thread point
+	DR_BENCHMARK_SCALING(PublishThreads, std::vector<u32>{ 1, 2, 4, 8 }) {
+		return runner.RunScaling([&]() { pubSub.Publish(1); }, threadCounts);
+	}
+
+The body gets the executable's runner (duration, warmup, ...) and, for parameterized benchmarks, arg
+(or threadCounts for scaling benchmarks).
+*/
+namespace Benchmark {
+	// Runs the benchmark with the runner the executable configured (duration, warmup, ...)
+	using BenchmarkFunc = std::function<Report(const Runner& runner)>;
+	using ParameterizedFunc = std::function<Report(const Runner& runner, s64 arg)>;
+	using ScalingFunc = std::function<std::vector<ScalingPoint>(const Runner& runner, const std::vector<u32>& threadCounts)>;
+	// Reports named after what distinguishes them, the registry prefixes the benchmark's name
+	using MultiBenchmarkFunc = std::function<std::vector<Report>(const Runner& runner)>;
+
+	struct RegisteredBenchmark {
+		std::string Name;
+		BenchmarkFunc Func;
+		// Set instead of Func for benchmarks with several reports, e.g. one per thread count
+		MultiBenchmarkFunc MultiFunc{};
+	};
+
+	// low, low * multiplier, low * multiplier^2, ... and high (sizes, thread counts, ...)
+	std::vector<s64> Range(s64 low, s64 high, s64 multiplier = 8);
+	// low, low + step, ... up to and including high
+	std::vector<s64> DenseRange(s64 low, s64 high, s64 step = 1);
+
+	class Registry {
+	public:
+		static Registry& Get();
+
+		void Add(std::string name, BenchmarkFunc func);
+		// Adds name/arg for each of the args
+		void Add(const std::string& name, ParameterizedFunc func, const std::vector<s64>& args);
+		// Runs func once with every thread count, reported as name/threads for each point
+		void AddScaling(std::string name, ScalingFunc func, std::vector<u32> threadCounts);
+
+		const std::vector<RegisteredBenchmark>& GetAll() const;
+		// Benchmarks whose name the filter matches (anywhere in the name, like grep)
+		std::vector<const RegisteredBenchmark*> Find(const std::regex& filter) const;
+
+		// Runs every (matching) benchmark in registration order, the reports are named after the benchmarks
+		std::vector<Report> RunAll(const Runner& runner) const;
+		std::vector<Report> RunAll(const Runner& runner, const std::regex& filter) const;
+
+	private:
+		std::vector<RegisteredBenchmark> m_Benchmarks;
+	};
+
+	// Registers from a static initializer, prefer DR_BENCHMARK
+	struct Registrar {
+		Registrar(std::string name, BenchmarkFunc func) {
+			Registry::Get().Add(std::move(name), std::move(func));
+		}
+		Registrar(std::string name, ParameterizedFunc func) {
+			Registry::Get().Add(std::move(name), [func = std::move(func)](const Runner& runner) { return func(runner, 0); });
+		}
+		Registrar(const std::string& name, ParameterizedFunc func, const std::vector<s64>& args) {
+			Registry::Get().Add(name, std::move(func), args);
+		}
+		Registrar(std::string name, ScalingFunc func, std::vector<u32> threadCounts) {
+			Registry::Get().AddScaling(std::move(name), std::move(func), std::move(threadCounts));
+		}
+	};
+
+	#define DR_BENCHMARK(name, ...) \
+		static Benchmark::Report name(const Benchmark::Runner& runner, s64 arg); \
+		static Benchmark::Registrar name##Registrar(#name, name __VA_OPT__(,) __VA_ARGS__); \
+		static Benchmark::Report name([[maybe_unused]] const Benchmark::Runner& runner, [[maybe_unused]] s64 arg)
+
+	// The thread counts are a std::vector<u32>
+	#define DR_BENCHMARK_SCALING(name, ...) \
+		static std::vector<Benchmark::ScalingPoint> name(const Benchmark::Runner& runner, const std::vector<u32>& threadCounts); \
+		static Benchmark::Registrar name##Registrar(#name, Benchmark::ScalingFunc(name), __VA_ARGS__); \
+		static std::vector<Benchmark::ScalingPoint> name(const Benchmark::Runner& runner, const std::vector<u32>& threadCounts)
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Core/Instrumentation/Benchmark/Benchmark.h"
+
+namespace Benchmark {
+	// Where a set of reports was measured, so runs on different machines or builds aren't compared blindly
+	struct Environment {
+		std::string CpuModel;
+		u32 LogicalCores{ 0 };
+		// Linux cpufreq governor of cpu0 (anything but "performance" adds noise), empty elsewhere
+		std::string Governor;
+		std::string Compiler;
+		std::string BuildType;
+		std::string CompilerFlags;
+		std::chrono::system_clock::time_point Time;
+	};
+
+	Environment CaptureEnvironment();
+
+	// A type erased Result, what gets exported and compared against a baseline
+	struct Report {
+		std::string Name;
+		Stats RuntimeStats{ std::vector<f64>{} };
+		std::vector<std::pair<std::string, Stats>> MonitorStats;
+		std::vector<std::pair<std::string, Stats>> CounterStats;
+		std::optional<Stats> Ipc;
+		u64 Iterations{ 0 };
+		u64 BatchSize{ 1 };
+		size_t LowOutliers{ 0 };
+		size_t HighOutliers{ 0 };
+		// Calls per second over all threads, for reports of a ScalingPoint
+		std::optional<f64> Throughput;
+		// Per thread throughput relative to the first point of the same scaling run, 1.0 is perfect scaling
+		std::optional<f64> Efficiency;
+		// Per iteration runtimes (in RuntimeStats' unit) for testing a change against a baseline.
+		// Empty for reports of a ScalingPoint and baselines written before samples were stored.
+		std::vector<f64> Samples;
+	};
+
+	template<typename TResult>
+	Report MakeReport(std::string name, const Result<TResult>& result) {
+		Report report{
+			.Name = std::move(name),
+			.RuntimeStats = result.RuntimeStats,
+			.MonitorStats = {},
+			.CounterStats = {},
+			.Ipc = result.Ipc,
+			.Iterations = result.Iterations,
+			.BatchSize = result.BatchSize,
+			.LowOutliers = result.LowOutliers,
+			.HighOutliers = result.HighOutliers,
+			.Throughput = std::nullopt,
+			.Efficiency = std::nullopt,
+			.Samples = result.Samples
+		};
+		for (const auto& [type, stats] : result.MonitorStats) {
+			report.MonitorStats.emplace_back(ToString(type), stats);
+		}
+		for (const auto& [counter, stats] : result.CounterStats) {
+			report.CounterStats.emplace_back(ToString(counter), stats);
+		}
+		return report;
+	}
+
+	// For registered benchmarks, the registry fills in the name
+	template<typename TResult>
+	Report MakeReport(const Result<TResult>& result) {
+		return MakeReport("", result);
+	}
+
+	// RuntimeStats is the latency of all threads combined
+	Report MakeReport(std::string name, const ScalingPoint& point);
+	Report MakeReport(const ScalingPoint& point);
+
+	// { "environment": {...}, "benchmarks": [ { "name": ..., "runtime": {...}, ... } ] }
+	std::string ToJson(const Environment& environment, const std::vector<Report>& reports);
+
+	// Most samples a csv row keeps, larger sets are reduced to evenly spaced quantiles
+	constexpr size_t MaxCsvSamples = 256;
+
+	// One row per report with the runtime stats and samples, readable by ReadCsv (which is what baselines are stored as)
+	std::string ToCsv(const std::vector<Report>& reports);
+
+	// Only the name, runtime stats, iteration counts and samples are restored.  Also reads csvs written
+	// before samples were stored.  Throws on malformed input.
+	std::vector<Report> ReadCsv(const std::string& csv);
+
+	struct Regression {
+		std::string Name;
+		// Medians in nanoseconds
+		f64 BaselineMedian{ 0.0 };
+		f64 CurrentMedian{ 0.0 };
+		// (current - baseline) / baseline, 0.1 is 10% slower
+		f64 Change{ 0.0 };
+		// Of the Mann-Whitney test, when both sides had samples
+		std::optional<f64> PValue;
+	};
+
+	// Benchmarks whose median runtime grew by more than threshold (0.1 = 10%) compared to the baseline
+	// with the same name and, when both have samples, whose samples differ significantly at the given
+	// confidence, so a single noisy run doesn't count.  Benchmarks missing from either side are ignored.
+	std::vector<Regression> FindRegressions(const std::vector<Report>& baseline, const std::vector<Report>& current, f64 threshold, f64 confidence = 0.95);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <vector>
+
+#include "Core/Platform/Types.h"
+#include "Core/Instrumentation/Benchmark/Stats.h"
+
+namespace Benchmark {
+	// One thread count of Runner::RunScaling
+	struct ScalingPoint {
+		u32 Threads{ 0 };
+		// Calls per second, summed over the threads
+		f64 Throughput{ 0.0 };
+		// Per thread throughput relative to the first point's, 1.0 is perfect scaling
+		f64 Efficiency{ 0.0 };
+		// Per call runtime of every thread combined
+		Stats Latency{ std::vector<f64>{} };
+		// Per call runtime of each thread, uneven threads point at unfair locks or starvation
+		std::vector<Stats> ThreadLatency;
+		// Timed calls over all threads
+		u64 Iterations{ 0 };
+	};
+
+	// Restricts the calling thread to one logical cpu, false if the platform doesn't allow it
+	bool PinCurrentThread(u32 cpu);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <initializer_list>
 #include <algorithm>
 #include <numeric>
 #include <format>
@@ -8,9 +9,10 @@
 
 #include "Core/Platform/Types.h"
 #include "Core/Constexpr/ConstexprMath.h"
+#include "Core/Instrumentation/Benchmark/Histogram.h"
 
 struct Stats {
-	constexpr Stats(const std::vector<f64>& values, const std::string& unit) 
+	constexpr Stats(const std::vector<f64>& values, const std::string& unit = "") 
 		: Unit(unit)
 	{
 		if (values.empty()) return;
@@ -38,6 +40,25 @@ struct Stats {
 		StdDev = Constexpr::Sqrt(variance);
 	}
 
+	// Keeps Stats({ 1.0, 2.0 }) from being ambiguous with the Histogram overload
+	constexpr Stats(std::initializer_list<f64> values, const std::string& unit = "")
+		: Stats(std::vector<f64>(values), unit)
+	{}
+
+	// Percentiles are approximated from the buckets, the rest are exact
+	constexpr Stats(const Histogram& histogram, const std::string& unit = "")
+		: Mean(histogram.Mean())
+		, Median(histogram.Percentile(50.0))
+		, Min(histogram.Min())
+		, Max(histogram.Max())
+		, StdDev(histogram.StdDev())
+		, Percent75(histogram.Percentile(75.0))
+		, Percent90(histogram.Percentile(90.0))
+		, Percent99(histogram.Percentile(99.0))
+		, Count(histogram.Count())
+		, Unit(unit)
+	{}
+
 	std::ostream& operator<<(std::ostream& stream);
 
 	constexpr Stats& operator*=(f64 factor) {
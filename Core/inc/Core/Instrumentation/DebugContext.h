@@ -4,16 +4,19 @@
 #include <thread>
 
 namespace Debug {
+	// Keeps the source_location itself: file and function names are string literals with static
+	// storage, so nothing is copied and the pointers can be used as identities for caching
 	struct Context {
 		Context(std::source_location sourceLoc = std::source_location::current()) :
-			FileName(sourceLoc.file_name()),
-			Function(sourceLoc.function_name()),
+			Location(sourceLoc),
 			LineNumber(sourceLoc.line()),
 			ThreadId(std::this_thread::get_id())
 		{}
 
-		std::string FileName{};
-		std::string Function{};
+		const char* FileName() const { return Location.file_name(); }
+		const char* Function() const { return Location.function_name(); }
+
+		std::source_location Location{};
 		size_t LineNumber{0};
 		std::thread::id ThreadId{};
 	};
@@ -3,12 +3,16 @@
 #include "Core/DesignPatterns/ServiceLocator.h"
 #include "Core/Instrumentation/Logging.h"
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <regex>
-#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
 
 template<typename T>
-struct PubSub;
+struct ConcurrentPubSub;
 
 namespace Log {
 	struct Filter {
@@ -17,10 +21,27 @@ namespace Log {
 		Filter& WithCustomMatcher(std::function<bool(const Entry&)> matcher);
 
 		bool Matches(const Entry& entry) const;
+		// Lowest level this filter can accept
+		Level MinLevel() const;
+		// How often the file pattern was run rather than answered from the cache, for tests
+		size_t FilePatternEvaluations() const;
 
 	private:
+		// Source file names are string literals, so the regex result is cached per file name pointer.
+		// Shared between copies of the filter, which all use the same pattern.
+		struct FilePatternCache {
+			explicit FilePatternCache(const std::regex& pattern) : Pattern(pattern) {}
+
+			bool Matches(const char* fileName);
+
+			std::regex Pattern;
+			std::shared_mutex Mutex;
+			std::unordered_map<const char*, bool> Results;
+			std::atomic<size_t> Evaluations{ 0 };
+		};
+
 		std::optional<Level> m_Level;
-		std::optional<std::regex> m_FilePattern;
+		std::shared_ptr<FilePatternCache> m_FilePattern;
 		std::optional<std::function<bool(const Entry&)>> m_CustomMatcher;
 	};
 
@@ -30,6 +51,12 @@ namespace Log {
 
 		virtual void Write(const Entry& entry) = 0;
 
+	protected:
+		// Stops delivery, waiting for in-flight writes.  Every sink must call this first thing in its
+		// destructor: ~ISink runs after the derived sink is gone, when a concurrent publish would
+		// call the pure virtual Write.
+		void Unsubscribe();
+
 	private:
 		size_t m_Handle{ std::numeric_limits<size_t>::max() };
 		Filter m_Filter;
@@ -6,6 +6,9 @@
 
 struct AssertToException : public Log::ISink {
     AssertToException() : Log::ISink(Log::Filter().WithLevel(Log::Level::Error)) {}
+    ~AssertToException() override {
+        Unsubscribe();
+    }
 
     void Write(const Log::Entry& entry) override {
         Require::False(true, entry.Message);
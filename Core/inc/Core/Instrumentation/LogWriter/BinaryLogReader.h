@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Core/Instrumentation/Logging.h"
+#include "Core/Platform/Types.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Decodes segments written by BinaryLogWriter
+namespace BinaryLogReader {
+	struct Record {
+		Log::Level LogLevel{};
+		std::chrono::system_clock::time_point Time{};
+		std::string FileName{};
+		std::string Function{};
+		u32 LineNumber{ 0 };
+		u64 ThreadId{ 0 };
+		std::string Message{};
+	};
+
+	// Throws if the file is not a binary log segment
+	std::vector<Record> ReadSegment(const std::string& path);
+
+	// Segments in the directory written with the given base name, oldest first
+	std::vector<std::string> FindSegments(const std::string& directory, const std::string& baseName);
+
+	// One line of text, similar to StdOutLogWriter with a timestamp and thread id
+	std::string ToString(const Record& record);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Core/Instrumentation/ISink.h"
+#include "Core/Platform/Types.h"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace BinaryLogImpl {
+	class MappedSegment;
+}
+
+/*
+Writes entries as compact binary records into preallocated, memory mapped segment files
+({Directory}/{BaseName}.000000.drlog, .000001, ...).  File and function names are interned per
+segment (by address), so each entry costs a few integers plus the message bytes.
+
+When a segment is full the writer rotates to the next one, deleting the oldest segments
+beyond MaxSegments.  Use BinaryLogReader (or the LogDecoder tool) to turn them back into text.
+*/
+struct BinaryLogWriter : public Log::ISink {
+	struct Options {
+		std::string Directory{ "." };
+		std::string BaseName{ "log" };
+		size_t SegmentSize{ 16 * 1024 * 1024 };
+		// 0 keeps every segment
+		size_t MaxSegments{ 0 };
+	};
+
+	BinaryLogWriter(Log::Filter filter, Options options);
+	~BinaryLogWriter() override;
+
+	BinaryLogWriter(const BinaryLogWriter&) = delete;
+	BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+	void Write(const Log::Entry& entry) override;
+
+	// Paths of the segments written so far which have not been deleted by rotation, oldest first
+	std::deque<std::string> GetSegments() const;
+
+private:
+	void OpenNextSegment();
+	u32 Intern(const char* str, char*& out);
+	size_t InternCost(const char* str) const;
+
+	Options m_Options;
+	mutable std::mutex m_Mutex;
+	std::unique_ptr<BinaryLogImpl::MappedSegment> m_Segment;
+	size_t m_Used{ 0 };
+	size_t m_NextSegmentIndex{ 0 };
+	std::deque<std::string> m_SegmentPaths;
+	// Keyed by address, file and function names come from std::source_location literals
+	std::unordered_map<const char*, u32> m_InternedStrings;
+};
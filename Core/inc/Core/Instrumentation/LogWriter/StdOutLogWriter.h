@@ -4,6 +4,7 @@
 
 struct StdOutLogWriter : public Log::ISink {
 	StdOutLogWriter(Log::Filter filter);
+	~StdOutLogWriter() override;
 
 	void Write(const Log::Entry& entry) override;
 };
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <source_location>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <format>
+#include <functional>
+#include <type_traits>
 
 #include "Core/Instrumentation/DebugContext.h"
 
@@ -18,7 +22,7 @@ namespace Log {
 	struct Entry {
 		Entry(Level level, std::string msg, Debug::Context context)
 			: LogLevel(level)
-			, Message(msg)
+			, Message(std::move(msg))
 			, Time(std::chrono::system_clock::now())
 			, Context(context)
 		{}
@@ -29,16 +33,103 @@ namespace Log {
 		Debug::Context Context{};
 	};
 
+	enum struct OverflowPolicy {
+		Block,     // Wait for the writer thread to make room
+		Drop,      // Discard the new entry
+		DropOldest // Discard the oldest queued entry to make room
+	};
+
+	struct AsyncOptions {
+		size_t QueueCapacity{ 8192 };
+		size_t BatchSize{ 256 };
+		OverflowPolicy Overflow{ OverflowPolicy::Block };
+	};
+
+	// Producers push entries into a bounded lock-free queue and a background thread publishes
+	// them to the sinks in batches.  Errors are still written on the calling thread, after every
+	// queued entry, so asserts keep their behaviour.
+	// Enabling or disabling must not race with other threads logging.  The sinks' ConcurrentPubSub
+	// is looked up (or created) once here, it must stay in the ServiceLocator until DisableAsync.
+	void EnableAsync(AsyncOptions options = {});
+	// Drains the queue and stops the writer thread, logging becomes synchronous again
+	void DisableAsync();
+	bool IsAsync();
+	// Number of entries discarded by the overflow policy since async logging was enabled
+	size_t DroppedCount();
+
+	// Blocks until every entry logged so far has been written to the sinks
 	void Flush();
 
+	namespace Detail {
+		// Bit per level, set while at least one sink's filter accepts that level
+		extern std::atomic<unsigned> EnabledLevels;
+
+		void AddSinkLevel(Level minLevel);
+		void RemoveSinkLevel(Level minLevel);
+
+		using Formatter = std::move_only_function<std::string()>;
+		void WriteDeferred(Level level, std::source_location loc, Formatter formatter);
+
+		// Views may point at temporaries which are gone by the time the background writer
+		// formats the entry, so anything string-like is copied into a std::string
+		template<typename T>
+		auto CaptureArg(T&& arg) {
+			using Decayed = std::decay_t<T>;
+			if constexpr (!std::is_same_v<Decayed, std::string> && std::is_convertible_v<const Decayed&, std::string_view>) {
+				return std::string(std::string_view(arg));
+			}
+			else {
+				return Decayed(std::forward<T>(arg));
+			}
+		}
+	}
+
+	// Cheap runtime check: does any sink want entries of this level
+	inline bool IsEnabled(Level level) {
+		return (Detail::EnabledLevels.load(std::memory_order_relaxed) & (1u << static_cast<unsigned>(level))) != 0;
+	}
+
+	// Copies the arguments and defers std::format to whoever writes the entry
+	// (the background writer when async logging is enabled).  Prefer the DR_LOG macros which
+	// skip the call, including evaluating the arguments, when the level is disabled.
+	template<typename... Args>
+	void Write(Level level, std::source_location loc, std::format_string<Args...> format, Args&&... args) {
+		Detail::WriteDeferred(level, loc, [format = format.get(), ...captured = Detail::CaptureArg(std::forward<Args>(args))]() {
+			return std::vformat(format, std::make_format_args(captured...));
+		});
+	}
+
 	void Debug(const std::string& message, std::source_location loc = std::source_location::current());
 	void Info(const std::string& message, std::source_location loc = std::source_location::current());
 	void Warn(const std::string& message, std::source_location loc = std::source_location::current());
 	void Error(const std::string& message, std::source_location loc = std::source_location::current());
 
+	// Levels below DR_MIN_LOG_LEVEL (0 = Debug ... 3 = Error) are compiled out entirely
+	#ifndef DR_MIN_LOG_LEVEL
+		#ifdef FINAL
+			#define DR_MIN_LOG_LEVEL 4
+		#else
+			#define DR_MIN_LOG_LEVEL 0
+		#endif
+	#endif
+
+	#define DR_LOG(level, format, ...) \
+		do { \
+			if constexpr (static_cast<int>(level) >= DR_MIN_LOG_LEVEL) { \
+				if (Log::IsEnabled(level)) { \
+					Log::Write(level, std::source_location::current(), format __VA_OPT__(,) __VA_ARGS__); \
+				} \
+			} \
+		} while(false)
+
+	#define DR_LOG_DEBUG(format, ...) DR_LOG(Log::Level::Debug, format __VA_OPT__(,) __VA_ARGS__)
+	#define DR_LOG_INFO(format, ...) DR_LOG(Log::Level::Info, format __VA_OPT__(,) __VA_ARGS__)
+	#define DR_LOG_WARN(format, ...) DR_LOG(Log::Level::Warning, format __VA_OPT__(,) __VA_ARGS__)
+	#define DR_LOG_ERROR(format, ...) DR_LOG(Log::Level::Error, format __VA_OPT__(,) __VA_ARGS__)
+
 	#define DR_ASSERT_MSG(condition, message) \
 		if(!(condition)) { \
-			Log::Error(std::format("ASSERT: '{}' {}", #condition, message)); \
+			DR_LOG_ERROR("ASSERT: '{}' {}", #condition, message); \
 		}
 
 	#define DR_ASSERT(condition) DR_ASSERT_MSG(condition, "")
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Core/DesignPatterns/ConcurrentPubSub.h"
+#include "Core/Instrumentation/Benchmark/Histogram.h"
+#include "Core/Platform/Types.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+Latency/size metrics which any number of threads can record into without sharing a cache line.
+
+Each thread records into its own pair of histograms per metric.  Collect (called by the aggregator
+thread, or directly) flips every recorder to its other histogram, waits for a record which is in
+flight on the old one, and merges it.  Recording never takes a lock; the first record of a metric
+on a thread registers the thread's recorder under a mutex.
+
+	auto& latency = registry.Get("Request");
+	registry.OnSnapshot().Subscribe([](const Metrics::Snapshot& snapshot) { ... });
+	registry.StartAggregator(1s);
+	...
+	ScopedTimer timer(latency);  // or latency.Record(value)
+*/
+namespace Metrics {
+	namespace Detail {
+		struct Recorder;
+	}
+
+	class Metric {
+	public:
+		Metric(std::string name, const Histogram& layout);
+		~Metric();
+
+		Metric(const Metric&) = delete;
+		Metric& operator=(const Metric&) = delete;
+
+		void Record(f64 value);
+
+		template<typename Rep, typename Period>
+		void Record(std::chrono::duration<Rep, Period> elapsed) {
+			Record(std::chrono::duration<f64, std::micro>(elapsed).count());
+		}
+
+		const std::string& Name() const { return m_Name; }
+
+		// Moves everything recorded since the last drain into the returned histogram
+		Histogram Drain();
+
+	private:
+		Detail::Recorder& GetRecorder();
+
+		std::string m_Name;
+		Histogram m_Layout;
+		// Unique across registries (never reused), keys the thread local recorder cache
+		size_t m_Id;
+		std::mutex m_RecordersMutex;
+		std::vector<std::shared_ptr<Detail::Recorder>> m_Recorders;
+	};
+
+	struct MetricSnapshot {
+		std::string Name;
+		// Samples recorded since the previous snapshot
+		Histogram Interval;
+		// Samples recorded since the registry was created
+		Histogram Total;
+	};
+
+	struct Snapshot {
+		std::chrono::system_clock::time_point Time;
+		std::vector<MetricSnapshot> Metrics;
+	};
+
+	class Registry {
+	public:
+		// Every metric uses the same histogram layout as the given (empty) histogram
+		explicit Registry(Histogram layout = Histogram());
+		~Registry();
+
+		Registry(const Registry&) = delete;
+		Registry& operator=(const Registry&) = delete;
+
+		// Creates the metric on first use, the reference is valid for the registry's lifetime
+		Metric& Get(const std::string& name);
+
+		// Merges every thread's samples, publishes and returns the snapshot
+		Snapshot Collect();
+
+		// Calls Collect every interval on a background thread until Stop (or destruction)
+		void StartAggregator(std::chrono::milliseconds interval);
+		void StopAggregator();
+
+		ConcurrentPubSub<Snapshot>& OnSnapshot() { return m_OnSnapshot; }
+
+	private:
+		Histogram m_Layout;
+		std::mutex m_MetricsMutex;
+		std::deque<Metric> m_Metrics;
+		std::vector<Histogram> m_Totals;
+		ConcurrentPubSub<Snapshot> m_OnSnapshot;
+
+		std::mutex m_AggregatorMutex;
+		std::condition_variable m_AggregatorSignal;
+		bool m_StopAggregator{ false };
+		std::thread m_Aggregator;
+	};
+}
@@ -1,23 +1,38 @@
 #pragma once
 
+#include "Core/Instrumentation/Metrics.h"
+
 #include <chrono>
 #include <functional>
 
 class ScopedTimer {
 public:
-    ScopedTimer(std::string&& label, std::function<void(std::string_view, std::chrono::microseconds)> onExit) 
+    // Allocates the label and callback, in hot code prefer the Metric overload or DR_TRACE_ZONE (Trace.h)
+    ScopedTimer(std::string&& label, std::function<void(std::string_view, std::chrono::microseconds)> onExit)
 		: m_Label(std::move(label))
-        , m_StartTime(std::chrono::high_resolution_clock::now())
+        , m_StartTime(std::chrono::steady_clock::now())
 		, m_OnExit(onExit)
     {}
 
+    // Records the elapsed microseconds into the calling thread's recorder, no allocation or locking
+    explicit ScopedTimer(Metrics::Metric& metric)
+        : m_StartTime(std::chrono::steady_clock::now())
+        , m_Metric(&metric)
+    {}
+
     ~ScopedTimer() {
-        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - m_StartTime);
-        m_OnExit(m_Label, elapsed);
+        auto elapsed = std::chrono::steady_clock::now() - m_StartTime;
+        if (m_Metric) {
+            m_Metric->Record(elapsed);
+        }
+        else {
+            m_OnExit(m_Label, std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+        }
     }
 
 private:
     std::string m_Label;
     std::chrono::steady_clock::time_point m_StartTime;
     std::function<void(std::string_view, std::chrono::microseconds)> m_OnExit{};
-};
\ No newline at end of file
+    Metrics::Metric* m_Metric{ nullptr };
+};
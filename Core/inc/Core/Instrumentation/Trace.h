@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Core/Platform/Types.h"
+
+#include <atomic>
+#include <string>
+
+/*
+Tracing profiler for nested zones, cheap enough (a couple dozen ns per zone) to leave in hot code.
+
+Zones are static (name, file, line) records, each thread appends begin/end events to its own ring
+buffer without locking or allocating.  Export converts the events to Chrome trace-event JSON, which
+chrome://tracing and https://ui.perfetto.dev open offline.
+
+	Trace::Start();
+	...
+	void Parse() {
+		DR_TRACE_FUNCTION();
+		for (auto& line : lines) {
+			DR_TRACE_ZONE("Line");
+			...
+		}
+	}
+	...
+	Trace::Stop();
+	*FileUtils::OpenForWrite("trace.json") << Trace::ToChromeJson();
+
+Define DR_DISABLE_TRACING to compile the zones out.
+*/
+namespace Trace {
+	// Must have static storage duration, events point at it
+	struct Zone {
+		const char* Name;
+		const char* File;
+		u32 Line;
+	};
+
+	struct Options {
+		// Per thread, rounded up to a power of two.  Once full the oldest events are overwritten.
+		// Buffers keep the size they were created with.
+		size_t EventsPerThread{ 1 << 16 };
+		// Read the x86 time stamp counter instead of steady_clock (cheaper, converted using
+		// steady_clock on export).  Ignored on other architectures.
+		bool UseTsc{ true };
+	};
+
+	// Starts a new trace, events from previous traces are no longer exported
+	void Start(Options options = {});
+	void Stop();
+
+	// Shown instead of the thread's number in the trace viewer
+	void SetThreadName(std::string name);
+
+	// Every thread's events since Start, including threads which have exited.  Zones still open
+	// are closed at their thread's last event, zones which began before the buffer wrapped are dropped.
+	std::string ToChromeJson();
+
+	namespace Detail {
+		extern std::atomic<bool> Enabled;
+
+		void Begin(const Zone& zone);
+		void End();
+	}
+
+	inline bool IsEnabled() {
+		return Detail::Enabled.load(std::memory_order_relaxed);
+	}
+
+	// Records the zone if tracing is enabled when the scope begins
+	class ScopedZone {
+	public:
+		explicit ScopedZone(const Zone& zone)
+			: m_Recording(IsEnabled())
+		{
+			if (m_Recording) Detail::Begin(zone);
+		}
+
+		~ScopedZone() {
+			if (m_Recording) Detail::End();
+		}
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+
+	private:
+		bool m_Recording;
+	};
+
+	#define DR_TRACE_CONCAT_IMPL(a, b) a##b
+	#define DR_TRACE_CONCAT(a, b) DR_TRACE_CONCAT_IMPL(a, b)
+
+	#ifdef DR_DISABLE_TRACING
+		#define DR_TRACE_ZONE(name) do {} while(false)
+	#else
+		// name must be a string literal (or otherwise outlive the trace)
+		#define DR_TRACE_ZONE(name) \
+			static const Trace::Zone DR_TRACE_CONCAT(drTraceZone, __LINE__){ name, __FILE__, __LINE__ }; \
+			Trace::ScopedZone DR_TRACE_CONCAT(drTraceScope, __LINE__)(DR_TRACE_CONCAT(drTraceZone, __LINE__))
+	#endif
+
+	#define DR_TRACE_FUNCTION() DR_TRACE_ZONE(__func__)
+}
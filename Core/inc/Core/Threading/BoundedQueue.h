@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace Threading {
+    /*
+    Fixed capacity lock-free queue for any number of producers and consumers (Dmitry Vyukov's
+    bounded MPMC queue).  Each cell carries a sequence number which tells a producer whether the
+    cell is free for the current lap and a consumer whether it holds a value, so a push or pop is
+    a single CAS on the shared position plus one store on the cell.
+
+    Capacity is rounded up to a power of two.  TryPush/TryPop never block, callers decide what
+    to do when the queue is full or empty.
+    */
+    template<typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity)
+            : m_Mask(std::bit_ceil(std::max(size_t(2), capacity)) - 1)
+            , m_Cells(std::make_unique<Cell[]>(m_Mask + 1))
+        {
+            for (size_t i = 0u; i <= m_Mask; i++) {
+                m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~BoundedQueue() {
+            while (TryPop()) {}
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        template<typename U>
+        bool TryPush(U&& value) {
+            auto pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &m_Cells[pos & m_Mask];
+                auto sequence = cell->Sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                }
+                else if (diff < 0) {
+                    return false; // full
+                }
+                else {
+                    pos = m_EnqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (cell->Storage) T(std::forward<U>(value));
+            cell->Sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::optional<T> TryPop() {
+            auto pos = m_DequeuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &m_Cells[pos & m_Mask];
+                auto sequence = cell->Sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0) {
+                    if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                }
+                else if (diff < 0) {
+                    return std::nullopt; // empty
+                }
+                else {
+                    pos = m_DequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            auto* value = std::launder(reinterpret_cast<T*>(cell->Storage));
+            std::optional<T> result{ std::move(*value) };
+            value->~T();
+            cell->Sequence.store(pos + m_Mask + 1, std::memory_order_release);
+            return result;
+        }
+
+        // Approximate when other threads are pushing or popping
+        bool Empty() const {
+            return m_EnqueuePos.load(std::memory_order_acquire) == m_DequeuePos.load(std::memory_order_acquire);
+        }
+
+        size_t Capacity() const {
+            return m_Mask + 1;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> Sequence;
+            alignas(T) std::byte Storage[sizeof(T)];
+        };
+
+        // Producers and consumers hammer different positions, keep them on separate cache lines
+        static constexpr size_t CacheLine = 64;
+
+        size_t m_Mask;
+        std::unique_ptr<Cell[]> m_Cells;
+        alignas(CacheLine) std::atomic<size_t> m_EnqueuePos{ 0 };
+        alignas(CacheLine) std::atomic<size_t> m_DequeuePos{ 0 };
+    };
+}
@@ -0,0 +1,493 @@
+#pragma once
+
+#include "Core/Threading/ThreadPool.h"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <latch>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/*
+How to use:
+    Threading::Scheduler scheduler{};
+
+    Threading::Task<int> Load(Threading::Scheduler& scheduler, int id) {
+        co_await scheduler.Schedule(); // continue on a pool thread
+        co_return id * 2;
+    }
+
+    Threading::Task<int> Sum(Threading::Scheduler& scheduler) {
+        std::vector<Threading::Task<int>> loads;
+        for(int i = 0; i < 1000; i++) {
+            loads.push_back(Load(scheduler, i));
+        }
+        auto values = co_await Threading::WhenAll(std::move(loads));
+        co_return std::accumulate(values.begin(), values.end(), 0);
+    }
+
+    int total = Threading::SyncWait(Sum(scheduler));
+
+Tasks are lazy: nothing runs until the task is awaited (or passed to SyncWait).
+A task can only be awaited once, its result is moved out.
+*/
+
+namespace Threading {
+    template<typename T = void>
+    class Task;
+
+    namespace Detail {
+        struct TaskPromiseBase {
+            struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                    auto continuation = handle.promise().Continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+
+                void await_resume() noexcept {}
+            };
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            FinalAwaiter final_suspend() noexcept { return {}; }
+
+            std::coroutine_handle<> Continuation{};
+        };
+
+        template<typename T>
+        struct TaskPromise : TaskPromiseBase {
+            Task<T> get_return_object() noexcept;
+
+            template<typename U>
+            void return_value(U&& value) {
+                m_Result.template emplace<1>(std::forward<U>(value));
+            }
+
+            void unhandled_exception() noexcept {
+                m_Result.template emplace<2>(std::current_exception());
+            }
+
+            T TakeResult() {
+                if (m_Result.index() == 2) {
+                    std::rethrow_exception(std::get<2>(m_Result));
+                }
+                return std::move(std::get<1>(m_Result));
+            }
+
+        private:
+            std::variant<std::monostate, T, std::exception_ptr> m_Result;
+        };
+
+        template<>
+        struct TaskPromise<void> : TaskPromiseBase {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept {
+                m_Exception = std::current_exception();
+            }
+
+            void TakeResult() {
+                if (m_Exception) {
+                    std::rethrow_exception(m_Exception);
+                }
+            }
+
+        private:
+            std::exception_ptr m_Exception{};
+        };
+    }
+
+    template<typename T>
+    class [[nodiscard]] Task {
+    public:
+        using promise_type = Detail::TaskPromise<T>;
+        using value_type = T;
+
+        Task() = default;
+        explicit Task(std::coroutine_handle<promise_type> handle) : m_Handle(handle) {}
+        Task(Task&& other) noexcept : m_Handle(std::exchange(other.m_Handle, {})) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (m_Handle) m_Handle.destroy();
+                m_Handle = std::exchange(other.m_Handle, {});
+            }
+            return *this;
+        }
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task() {
+            if (m_Handle) m_Handle.destroy();
+        }
+
+        bool IsReady() const {
+            return !m_Handle || m_Handle.done();
+        }
+
+        auto operator co_await() noexcept {
+            struct Awaiter {
+                std::coroutine_handle<promise_type> Handle;
+
+                bool await_ready() const noexcept {
+                    return !Handle || Handle.done();
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                    Handle.promise().Continuation = awaiting;
+                    return Handle;
+                }
+
+                T await_resume() {
+                    if (!Handle) throw "Awaiting an empty task";
+                    return Handle.promise().TakeResult();
+                }
+            };
+            return Awaiter{ m_Handle };
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_Handle{};
+    };
+
+    namespace Detail {
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept {
+            return Task<T>{ std::coroutine_handle<TaskPromise<T>>::from_promise(*this) };
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+            return Task<void>{ std::coroutine_handle<TaskPromise<void>>::from_promise(*this) };
+        }
+
+        // Counts outstanding children plus one for the awaiting coroutine, whoever arrives
+        // last resumes the awaiter.  This keeps the awaiter from being resumed before it has
+        // finished suspending.
+        struct WhenAllCounter {
+            explicit WhenAllCounter(size_t children) : Remaining(children + 1) {}
+
+            bool Arrive() {
+                return Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            }
+
+            std::atomic<size_t> Remaining;
+            std::coroutine_handle<> Awaiter{};
+        };
+
+        // Coroutine used to drive a Task from non-coroutine code.  It starts suspended and
+        // reports completion once the frame has reached its final suspend point, after which
+        // the owner may destroy it at any time, so nothing in the frame is touched after signalling.
+        struct DriverTask {
+            struct promise_type {
+                WhenAllCounter* Counter{ nullptr };
+                std::latch* Latch{ nullptr };
+
+                DriverTask get_return_object() noexcept {
+                    return DriverTask{ std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+                std::suspend_always initial_suspend() noexcept { return {}; }
+                auto final_suspend() noexcept {
+                    struct Awaiter {
+                        bool await_ready() const noexcept { return false; }
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                            if (auto* counter = handle.promise().Counter) {
+                                if (counter->Arrive()) return counter->Awaiter;
+                            }
+                            else if (auto* latch = handle.promise().Latch) {
+                                latch->count_down();
+                            }
+                            return std::noop_coroutine();
+                        }
+                        void await_resume() noexcept {}
+                    };
+                    return Awaiter{};
+                }
+                void return_void() noexcept {}
+                void unhandled_exception() noexcept { std::terminate(); }
+            };
+
+            DriverTask() = default;
+            explicit DriverTask(std::coroutine_handle<promise_type> handle) : Handle(handle) {}
+            DriverTask(DriverTask&& other) noexcept : Handle(std::exchange(other.Handle, {})) {}
+            DriverTask& operator=(DriverTask&& other) noexcept {
+                if (this != &other) {
+                    if (Handle) Handle.destroy();
+                    Handle = std::exchange(other.Handle, {});
+                }
+                return *this;
+            }
+            ~DriverTask() {
+                if (Handle) Handle.destroy();
+            }
+
+            std::coroutine_handle<promise_type> Handle{};
+        };
+
+        // Awaits the task and stores the outcome, never throws
+        template<typename T>
+        DriverTask Capture(Task<T>& task, std::optional<T>& outValue, std::exception_ptr& outException) {
+            try {
+                outValue.emplace(co_await task);
+            }
+            catch (...) {
+                outException = std::current_exception();
+            }
+        }
+
+        inline DriverTask Capture(Task<void>& task, std::exception_ptr& outException) {
+            try {
+                co_await task;
+            }
+            catch (...) {
+                outException = std::current_exception();
+            }
+        }
+
+        struct WhenAllAwaitable {
+            std::vector<DriverTask>& Drivers;
+            WhenAllCounter& Counter;
+
+            bool await_ready() const noexcept {
+                return Drivers.empty();
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiter) {
+                Counter.Awaiter = awaiter;
+                for (auto& driver : Drivers) {
+                    driver.Handle.promise().Counter = &Counter;
+                }
+                for (auto& driver : Drivers) {
+                    driver.Handle.resume();
+                }
+                return !Counter.Arrive();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        template<typename T>
+        struct WhenAnyState {
+            std::atomic<bool> Done{ false };
+            std::coroutine_handle<> Awaiter{};
+            size_t Index{ 0 };
+            std::optional<T> Value{};
+            std::exception_ptr Exception{};
+        };
+
+        template<>
+        struct WhenAnyState<void> {
+            std::atomic<bool> Done{ false };
+            std::coroutine_handle<> Awaiter{};
+            size_t Index{ 0 };
+            std::exception_ptr Exception{};
+        };
+
+        // Owns its child task and destroys itself when finished, so the losers of a WhenAny
+        // can keep running after the awaiter has moved on.
+        struct DetachedTask {
+            struct promise_type {
+                DetachedTask get_return_object() noexcept {
+                    return DetachedTask{ std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+                std::suspend_always initial_suspend() noexcept { return {}; }
+                std::suspend_never final_suspend() noexcept { return {}; }
+                void return_void() noexcept {}
+                void unhandled_exception() noexcept { std::terminate(); }
+            };
+
+            std::coroutine_handle<promise_type> Handle{};
+        };
+
+        template<typename T>
+        DetachedTask RaceOne(std::shared_ptr<WhenAnyState<T>> state, Task<T> task, size_t index) {
+            std::exception_ptr exception{};
+            std::optional<std::conditional_t<std::is_void_v<T>, std::monostate, T>> value{};
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    co_await task;
+                    value.emplace();
+                }
+                else {
+                    value.emplace(co_await task);
+                }
+            }
+            catch (...) {
+                exception = std::current_exception();
+            }
+
+            if (state->Done.exchange(true, std::memory_order_acq_rel)) co_return;
+
+            state->Index = index;
+            state->Exception = exception;
+            if constexpr (!std::is_void_v<T>) {
+                if (value.has_value()) state->Value = std::move(*value);
+            }
+            state->Awaiter.resume();
+        }
+    }
+
+    template<typename T>
+    struct WhenAnyResult {
+        size_t Index;
+        T Value;
+    };
+
+    // Runs coroutines on a ThreadPool.  co_await Schedule() moves the current coroutine onto a worker.
+    class Scheduler {
+    public:
+        explicit Scheduler(ThreadPool& pool = ThreadPool::Default()) : m_Pool(pool) {}
+
+        auto Schedule() noexcept {
+            struct Awaiter {
+                ThreadPool& Pool;
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle) {
+                    Pool.Post([handle]() { handle.resume(); });
+                }
+                void await_resume() noexcept {}
+            };
+            return Awaiter{ m_Pool };
+        }
+
+        // Starts the task on the pool without waiting for it.  Exceptions are discarded.
+        template<typename T>
+        void Spawn(Task<T> task) {
+            [](Scheduler& scheduler, Task<T> toRun) -> Detail::DetachedTask {
+                co_await scheduler.Schedule();
+                try {
+                    co_await toRun;
+                }
+                catch (...) {}
+            }(*this, std::move(task)).Handle.resume();
+        }
+
+        ThreadPool& Pool() {
+            return m_Pool;
+        }
+
+    private:
+        ThreadPool& m_Pool;
+    };
+
+    // Blocks the calling thread until the task finishes
+    template<typename T>
+    T SyncWait(Task<T> task) {
+        std::latch done(1);
+        std::exception_ptr exception{};
+
+        if constexpr (std::is_void_v<T>) {
+            auto driver = Detail::Capture(task, exception);
+            driver.Handle.promise().Latch = &done;
+            driver.Handle.resume();
+            done.wait();
+            if (exception) std::rethrow_exception(exception);
+        }
+        else {
+            std::optional<T> value{};
+            auto driver = Detail::Capture(task, value, exception);
+            driver.Handle.promise().Latch = &done;
+            driver.Handle.resume();
+            done.wait();
+            if (exception) std::rethrow_exception(exception);
+            return std::move(*value);
+        }
+    }
+
+    // Runs all tasks concurrently and resumes once every one has finished.
+    // Results are in task order, the first exception (by task order) is rethrown.
+    template<typename T>
+    Task<std::vector<T>> WhenAll(std::vector<Task<T>> tasks) {
+        std::vector<std::optional<T>> values(tasks.size());
+        std::vector<std::exception_ptr> exceptions(tasks.size());
+        std::vector<Detail::DriverTask> drivers;
+        drivers.reserve(tasks.size());
+        for (size_t i = 0u; i < tasks.size(); i++) {
+            drivers.push_back(Detail::Capture(tasks[i], values[i], exceptions[i]));
+        }
+
+        Detail::WhenAllCounter counter(drivers.size());
+        co_await Detail::WhenAllAwaitable{ drivers, counter };
+
+        std::vector<T> result;
+        result.reserve(values.size());
+        for (size_t i = 0u; i < values.size(); i++) {
+            if (exceptions[i]) std::rethrow_exception(exceptions[i]);
+            result.push_back(std::move(*values[i]));
+        }
+        co_return result;
+    }
+
+    inline Task<void> WhenAll(std::vector<Task<void>> tasks) {
+        std::vector<std::exception_ptr> exceptions(tasks.size());
+        std::vector<Detail::DriverTask> drivers;
+        drivers.reserve(tasks.size());
+        for (size_t i = 0u; i < tasks.size(); i++) {
+            drivers.push_back(Detail::Capture(tasks[i], exceptions[i]));
+        }
+
+        Detail::WhenAllCounter counter(drivers.size());
+        co_await Detail::WhenAllAwaitable{ drivers, counter };
+
+        for (const auto& exception : exceptions) {
+            if (exception) std::rethrow_exception(exception);
+        }
+    }
+
+    namespace Detail {
+        template<typename T>
+        struct WhenAnyAwaitable {
+            // Held by reference, GCC 12 can release non-trivial co_await operands twice
+            const std::shared_ptr<WhenAnyState<T>>& State;
+            std::vector<Task<T>>& Tasks;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> awaiter) {
+                State->Awaiter = awaiter;
+                // The first finisher may resume the awaiter (destroying the awaiting frame) while
+                // we are still starting the others, so only touch locals from here on
+                std::vector<DetachedTask> racers;
+                racers.reserve(Tasks.size());
+                for (size_t i = 0u; i < Tasks.size(); i++) {
+                    racers.push_back(RaceOne<T>(State, std::move(Tasks[i]), i));
+                }
+                for (auto& racer : racers) {
+                    racer.Handle.resume();
+                }
+            }
+
+            void await_resume() noexcept {}
+        };
+    }
+
+    // Resumes as soon as the first task finishes, returning its index and result (or rethrowing
+    // its exception).  The other tasks keep running to completion in the background.
+    template<typename T>
+    Task<WhenAnyResult<T>> WhenAny(std::vector<Task<T>> tasks) {
+        if (tasks.empty()) throw "WhenAny requires at least one task";
+
+        auto state = std::make_shared<Detail::WhenAnyState<T>>();
+        co_await Detail::WhenAnyAwaitable<T>{ state, tasks };
+
+        if (state->Exception) std::rethrow_exception(state->Exception);
+        co_return WhenAnyResult<T>{ state->Index, std::move(*state->Value) };
+    }
+
+    // Returns the index of the first task to finish
+    inline Task<size_t> WhenAny(std::vector<Task<void>> tasks) {
+        if (tasks.empty()) throw "WhenAny requires at least one task";
+
+        auto state = std::make_shared<Detail::WhenAnyState<void>>();
+        co_await Detail::WhenAnyAwaitable<void>{ state, tasks };
+
+        if (state->Exception) std::rethrow_exception(state->Exception);
+        co_return state->Index;
+    }
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Core/Threading/Tasks.h"
+#include "Core/Constexpr/ConstexprGeometry.h"
+
+#include <array>
+#include <ranges>
+#include <vector>
+
+/*
+Runtime counterparts of Constexpr::ForEach which split the (inclusive) index space into
+tiles and run the tiles on a ThreadPool.
+
+    Vec3<s64> min{0, 0, 0};
+    Vec3<s64> max{4095, 4095, 15};
+    ParallelForEach(min, max, [&](Vec3<s64> pos) { grid[pos] = Step(pos); });
+
+    auto live = ParallelReduce(min, max, size_t(0),
+        [&](Vec3<s64> pos) { return grid[pos].IsAlive() ? size_t(1) : size_t(0); },
+        std::plus<size_t>{});
+
+Points inside a tile are visited in the same order as Constexpr::ForEach.  Tiles grow along the
+innermost axis first, so each tile walks contiguous memory for row-major storage.
+
+ParallelReduce folds each tile from the identity, then folds the tile results in tile order, so
+for a given tile size the result does not depend on the thread count or the scheduling.
+*/
+
+namespace Threading::Detail {
+    // Describes how a point type maps to loop axes, outermost first (matching Constexpr::ForEach)
+    template<typename Point>
+    struct GridAxes;
+
+    template<>
+    struct GridAxes<RowCol> {
+        static constexpr size_t Count = 2;
+        using Value = size_t;
+
+        static constexpr std::array<Value, Count> ToAxes(RowCol rc) { return { rc.Row, rc.Col }; }
+        static constexpr RowCol FromAxes(const std::array<Value, Count>& axes) { return { axes[0], axes[1] }; }
+    };
+
+    template<typename T>
+    struct GridAxes<Vec2<T>> {
+        static constexpr size_t Count = 2;
+        using Value = T;
+
+        static constexpr std::array<Value, Count> ToAxes(Vec2<T> v) { return { v.Y, v.X }; }
+        static constexpr Vec2<T> FromAxes(const std::array<Value, Count>& axes) { return { axes[1], axes[0] }; }
+    };
+
+    template<typename T>
+    struct GridAxes<Vec3<T>> {
+        static constexpr size_t Count = 3;
+        using Value = T;
+
+        static constexpr std::array<Value, Count> ToAxes(Vec3<T> v) { return { v.X, v.Y, v.Z }; }
+        static constexpr Vec3<T> FromAxes(const std::array<Value, Count>& axes) { return { axes[0], axes[1], axes[2] }; }
+    };
+
+    template<typename T>
+    struct GridAxes<Vec4<T>> {
+        static constexpr size_t Count = 4;
+        using Value = T;
+
+        static constexpr std::array<Value, Count> ToAxes(Vec4<T> v) { return { v.X, v.Y, v.Z, v.W }; }
+        static constexpr Vec4<T> FromAxes(const std::array<Value, Count>& axes) { return { axes[0], axes[1], axes[2], axes[3] }; }
+    };
+
+    template<typename Point>
+    concept GridPoint = requires { GridAxes<Point>::Count; };
+
+    // Roughly 16k points per tile, enough work to hide the scheduling overhead
+    constexpr size_t DefaultTilePoints = 1 << 14;
+
+    template<typename Point>
+    struct GridTiling {
+        using Axes = GridAxes<Point>;
+        static constexpr size_t N = Axes::Count;
+        using Value = typename Axes::Value;
+
+        GridTiling(Point min, Point max, size_t tilePoints) : Min(Axes::ToAxes(min)) {
+            auto maxAxes = Axes::ToAxes(max);
+            for (size_t axis = 0u; axis < N; axis++) {
+                if (maxAxes[axis] < Min[axis]) {
+                    TileCount = 0;
+                    return;
+                }
+                Extent[axis] = static_cast<size_t>(maxAxes[axis] - Min[axis]) + 1;
+            }
+
+            // Fill the tile budget from the innermost axis outwards
+            auto budget = std::max(size_t(1), tilePoints);
+            for (size_t i = 0u; i < N; i++) {
+                auto axis = N - 1 - i;
+                TileExtent[axis] = std::min(Extent[axis], budget);
+                budget = std::max(size_t(1), budget / TileExtent[axis]);
+            }
+
+            for (size_t axis = 0u; axis < N; axis++) {
+                TilesPerAxis[axis] = (Extent[axis] + TileExtent[axis] - 1) / TileExtent[axis];
+                TileCount *= TilesPerAxis[axis];
+            }
+        }
+
+        template<typename Func>
+        void VisitTile(size_t tile, Func& func) const {
+            std::array<size_t, N> begin{};
+            std::array<size_t, N> end{};
+            for (size_t i = 0u; i < N; i++) {
+                auto axis = N - 1 - i;
+                auto tileIndex = tile % TilesPerAxis[axis];
+                tile /= TilesPerAxis[axis];
+                begin[axis] = tileIndex * TileExtent[axis];
+                end[axis] = std::min(begin[axis] + TileExtent[axis], Extent[axis]);
+            }
+
+            std::array<Value, N> axes{};
+            Visit<0>(begin, end, axes, func);
+        }
+
+        std::array<Value, N> Min{};
+        std::array<size_t, N> Extent{};
+        std::array<size_t, N> TileExtent{};
+        std::array<size_t, N> TilesPerAxis{};
+        size_t TileCount{ 1 };
+
+    private:
+        template<size_t Axis, typename Func>
+        void Visit(const std::array<size_t, N>& begin, const std::array<size_t, N>& end, std::array<Value, N>& axes, Func& func) const {
+            for (auto offset = begin[Axis]; offset < end[Axis]; offset++) {
+                axes[Axis] = static_cast<Value>(Min[Axis] + static_cast<Value>(offset));
+                if constexpr (Axis + 1 == N) {
+                    func(Axes::FromAxes(axes));
+                }
+                else {
+                    Visit<Axis + 1>(begin, end, axes, func);
+                }
+            }
+        }
+    };
+
+    struct TileDone {};
+}
+
+// Calls func for every point in [min, max] (inclusive).  func is called concurrently from
+// multiple threads, the first exception is rethrown once all started tiles have finished.
+// tilePoints is the approximate number of points per tile, 0 picks a default.
+template<typename Point, typename Func>
+    requires Threading::Detail::GridPoint<Point>
+void ParallelForEach(Threading::ThreadPool& pool, Point min, Point max, Func func, size_t tilePoints = 0) {
+    Threading::Detail::GridTiling<Point> tiling(min, max, tilePoints == 0 ? Threading::Detail::DefaultTilePoints : tilePoints);
+    if (tiling.TileCount == 0) return;
+
+    ParallelMap(pool, std::views::iota(size_t(0), tiling.TileCount), [&](size_t tile) {
+        tiling.VisitTile(tile, func);
+        return Threading::Detail::TileDone{};
+    }, 1);
+}
+
+template<typename Point, typename Func>
+    requires Threading::Detail::GridPoint<Point>
+void ParallelForEach(Point min, Point max, Func func, size_t tilePoints = 0) {
+    ParallelForEach(Threading::ThreadPool::Default(), min, max, std::move(func), tilePoints);
+}
+
+template<typename Func>
+void ParallelForEach(Threading::ThreadPool& pool, RowCol max, Func func) {
+    ParallelForEach(pool, RowCol{ 0, 0 }, max, std::move(func));
+}
+
+template<typename Func>
+void ParallelForEach(RowCol max, Func func) {
+    ParallelForEach(Threading::ThreadPool::Default(), RowCol{ 0, 0 }, max, std::move(func));
+}
+
+// Maps every point in [min, max] (inclusive) and folds the results with reduce.
+// identity must be an identity of reduce (0 for plus, 1 for multiplies, ...) as it seeds every tile.
+template<typename Point, typename T, typename MapFunc, typename ReduceFunc>
+    requires Threading::Detail::GridPoint<Point>
+T ParallelReduce(Threading::ThreadPool& pool, Point min, Point max, T identity, MapFunc map, ReduceFunc reduce, size_t tilePoints = 0) {
+    Threading::Detail::GridTiling<Point> tiling(min, max, tilePoints == 0 ? Threading::Detail::DefaultTilePoints : tilePoints);
+    if (tiling.TileCount == 0) return identity;
+
+    auto partials = ParallelMap(pool, std::views::iota(size_t(0), tiling.TileCount), [&](size_t tile) {
+        T partial = identity;
+        auto fold = [&](Point point) { partial = reduce(std::move(partial), map(point)); };
+        tiling.VisitTile(tile, fold);
+        return partial;
+    }, 1);
+
+    T result = std::move(identity);
+    for (auto& partial : partials) {
+        result = reduce(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+template<typename Point, typename T, typename MapFunc, typename ReduceFunc>
+    requires Threading::Detail::GridPoint<Point>
+T ParallelReduce(Point min, Point max, T identity, MapFunc map, ReduceFunc reduce, size_t tilePoints = 0) {
+    return ParallelReduce(Threading::ThreadPool::Default(), min, max, std::move(identity), std::move(map), std::move(reduce), tilePoints);
+}
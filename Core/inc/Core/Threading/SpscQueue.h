@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace Threading {
+    /*
+    Fixed capacity lock-free queue for exactly one producer thread and one consumer thread.
+    Cheaper than BoundedQueue when that's all a handoff needs: no CAS, each side owns its position
+    and only reads the other's when its cached copy says the queue looks full (or empty).
+
+    Capacity is rounded up to a power of two.  TryPush/TryPop never block.
+    */
+    template<typename T>
+    class SpscQueue {
+    public:
+        explicit SpscQueue(size_t capacity)
+            : m_Mask(std::bit_ceil(std::max(size_t(2), capacity)) - 1)
+            , m_Cells(std::make_unique<Cell[]>(m_Mask + 1))
+        {}
+
+        ~SpscQueue() {
+            while (TryPop()) {}
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // Producer thread only
+        template<typename U>
+        bool TryPush(U&& value) {
+            auto tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail - m_CachedHead > m_Mask) {
+                m_CachedHead = m_Head.load(std::memory_order_acquire);
+                if (tail - m_CachedHead > m_Mask) return false; // full
+            }
+
+            new (m_Cells[tail & m_Mask].Storage) T(std::forward<U>(value));
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only
+        std::optional<T> TryPop() {
+            auto head = m_Head.load(std::memory_order_relaxed);
+            if (head == m_CachedTail) {
+                m_CachedTail = m_Tail.load(std::memory_order_acquire);
+                if (head == m_CachedTail) return std::nullopt; // empty
+            }
+
+            auto* value = std::launder(reinterpret_cast<T*>(m_Cells[head & m_Mask].Storage));
+            std::optional<T> result{ std::move(*value) };
+            value->~T();
+            m_Head.store(head + 1, std::memory_order_release);
+            return result;
+        }
+
+        // Approximate when the other thread is pushing or popping
+        bool Empty() const {
+            return m_Tail.load(std::memory_order_acquire) == m_Head.load(std::memory_order_acquire);
+        }
+
+        size_t Capacity() const {
+            return m_Mask + 1;
+        }
+
+    private:
+        struct Cell {
+            alignas(T) std::byte Storage[sizeof(T)];
+        };
+
+        // Each side's position and its cached copy of the other's share a cache line
+        static constexpr size_t CacheLine = 64;
+
+        size_t m_Mask;
+        std::unique_ptr<Cell[]> m_Cells;
+        alignas(CacheLine) std::atomic<size_t> m_Tail{ 0 };
+        size_t m_CachedHead{ 0 };
+        alignas(CacheLine) std::atomic<size_t> m_Head{ 0 };
+        size_t m_CachedTail{ 0 };
+    };
+}
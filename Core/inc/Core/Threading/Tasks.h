@@ -1,72 +1,394 @@
 #pragma once
 
+#include "Core/Threading/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
 #include <vector>
 
 using ProgressCallback = std::function<void(size_t, size_t, double)>;
 
-auto WhenAll(auto tasks, ProgressCallback progressCallback = nullptr) {
-    using namespace std::chrono_literals;
-    using FuncType = decltype(tasks)::value_type;
-	using ReturnType = std::invoke_result_t<FuncType>;
-    if(tasks.empty()) {
-		if constexpr (std::is_same_v<ReturnType, void>) {
-            std::promise<void> p;
-			return p.get_future();
-		}
-		else {
-            std::promise<std::vector<ReturnType>> p;
-            return p.get_future();
-		}
-	}
-
-    return std::async(std::launch::async, [tasks, progressCallback]() {
-        uint64_t MaxConcurrency = std::max(1ull, static_cast<uint64_t>(std::thread::hardware_concurrency()));
-        std::vector<std::future<ReturnType>> futures;
-        auto copy = tasks;
-        size_t finishedTasks = 0;
-        size_t totalTasks = tasks.size();
-        size_t currentTask = totalTasks;
-        if constexpr (std::is_same_v<ReturnType, void>) {
-            while (finishedTasks < totalTasks) {
-                auto taskCount = std::min(currentTask, static_cast<size_t>(MaxConcurrency - futures.size()));
-                for (size_t i = 0u; i < taskCount; i++) {
-                    futures.emplace_back(std::async(std::launch::async, copy[--currentTask]));
+namespace Threading {
+    enum struct CancelReason { Requested, Deadline, Failure };
+    constexpr std::string ToString(CancelReason reason) {
+        switch (reason) {
+        case CancelReason::Requested: return "Requested";
+        case CancelReason::Deadline: return "Deadline";
+        case CancelReason::Failure: return "Failure";
+        }
+        return "Unknown";
+    }
+
+    struct OperationCancelled : std::runtime_error {
+        explicit OperationCancelled(CancelReason reason)
+            : std::runtime_error("Operation cancelled: " + ToString(reason))
+            , Reason(reason)
+        {}
+
+        CancelReason Reason;
+    };
+
+    // Every exception thrown by the tasks of a single WhenAll, in the order they were caught
+    struct AggregateException : std::runtime_error {
+        explicit AggregateException(std::vector<std::exception_ptr> exceptions)
+            : std::runtime_error(std::to_string(exceptions.size()) + " task(s) failed")
+            , Exceptions(std::move(exceptions))
+        {}
+
+        std::vector<std::exception_ptr> Exceptions;
+    };
+
+    struct WhenAllOptions {
+        // Cancels outstanding work when stop is requested on the owning std::stop_source
+        std::stop_token StopToken{};
+        std::optional<std::chrono::steady_clock::time_point> Deadline{};
+        // Stop the remaining tasks as soon as one throws
+        bool CancelOnFailure{ true };
+        ProgressCallback Progress{ nullptr };
+    };
+}
+
+namespace Threading::Detail {
+    // Pre-sized result storage where each task writes its own slot, so no locking is needed.
+    // vector<bool> packs bits (neighbouring writes would race) and some types have no default,
+    // those fall back to optionals which are unwrapped at the end.
+    template<typename T>
+    struct OrderedResults {
+        static constexpr bool Direct = std::is_default_constructible_v<T> && !std::is_same_v<T, bool>;
+
+        explicit OrderedResults(size_t count) : m_Values(count) {}
+
+        void Set(size_t index, T&& value) {
+            m_Values[index] = std::move(value);
+        }
+
+        size_t Size() const {
+            return m_Values.size();
+        }
+
+        std::vector<T> Take() {
+            if constexpr (Direct) {
+                return std::move(m_Values);
+            }
+            else {
+                std::vector<T> result;
+                result.reserve(m_Values.size());
+                for (auto& value : m_Values) {
+                    result.emplace_back(std::move(*value));
                 }
-                for (int i = static_cast<int>(futures.size()) - 1; i >= 0; i--) {
-                    if (futures[i].wait_for(0ms) == std::future_status::ready) {
-                        std::swap(futures[i], futures.back());
-                        futures.pop_back();
-                        finishedTasks++;
-                        if (progressCallback) {
-                            progressCallback(finishedTasks, totalTasks, static_cast<double>(finishedTasks) / totalTasks);
-                        }
+                return result;
+            }
+        }
+
+    private:
+        std::vector<std::conditional_t<Direct, T, std::optional<T>>> m_Values;
+    };
+
+    template<typename Func>
+    using TaskResult = typename std::conditional_t<std::is_invocable_v<Func&, std::stop_token>,
+        std::invoke_result<Func&, std::stop_token>,
+        std::invoke_result<Func&>>::type;
+
+    template<typename ReturnType>
+    struct WhenAllState {
+        using ResultType = std::conditional_t<std::is_void_v<ReturnType>, void, std::vector<ReturnType>>;
+
+        struct Empty {
+            explicit Empty(size_t) {}
+        };
+        using Storage = std::conditional_t<std::is_void_v<ReturnType>, Empty, OrderedResults<ReturnType>>;
+
+        // aggregate: report every failure as an AggregateException rather than rethrowing the first
+        WhenAllState(size_t totalTasks, WhenAllOptions options, bool aggregate)
+            : Results(totalTasks)
+            , TotalTasks(totalTasks)
+            , Options(std::move(options))
+            , Aggregate(aggregate)
+            , ExternalStop(Options.StopToken, StopRequested{ this, CancelReason::Requested })
+        {}
+
+        ~WhenAllState() {
+            if (Watchdog.joinable()) {
+                Watchdog.request_stop();
+                Watchdog.join();
+            }
+        }
+
+        void StartWatchdog() {
+            if (!Options.Deadline.has_value()) return;
+
+            Watchdog = std::jthread([this, deadline = *Options.Deadline](std::stop_token watchdogToken) {
+                std::mutex mutex;
+                std::condition_variable_any condition;
+                std::unique_lock lock(mutex);
+                if (!condition.wait_until(lock, watchdogToken, deadline, []() { return false; })) {
+                    if (!watchdogToken.stop_requested()) {
+                        Cancel(CancelReason::Deadline);
                     }
                 }
+            });
+        }
+
+        void Run(size_t index, auto& task) {
+            auto token = Source.get_token();
+            if (token.stop_requested()) {
+                OnFinished();
+                return;
+            }
+
+            try {
+                if constexpr (std::is_void_v<ReturnType>) {
+                    Invoke(task, token);
+                }
+                else {
+                    Results.Set(index, Invoke(task, token));
+                }
+            }
+            catch (...) {
+                {
+                    std::lock_guard lock(Mutex);
+                    Exceptions.push_back(std::current_exception());
+                }
+                if (Options.CancelOnFailure) {
+                    Cancel(CancelReason::Failure);
+                }
+            }
+            OnFinished();
+        }
+
+        std::promise<ResultType> Promise;
+
+    private:
+        struct StopRequested {
+            WhenAllState* State;
+            CancelReason Reason;
+            void operator()() const { State->Cancel(Reason); }
+        };
+
+        static decltype(auto) Invoke(auto& task, std::stop_token token) {
+            if constexpr (std::is_invocable_v<decltype(task), std::stop_token>) {
+                return task(std::move(token));
+            }
+            else {
+                return task();
             }
         }
-        else {
-            std::vector<ReturnType> results;
-            results.reserve(tasks.size());
-
-            while (finishedTasks < totalTasks) {
-                auto taskCount = std::min(currentTask, MaxConcurrency - futures.size());
-                for (auto i = 0; i < taskCount; i++) {
-                    futures.emplace_back(std::async(std::launch::async, copy[--currentTask]));
+
+        void Cancel(CancelReason reason) {
+            // Only the first reason sticks
+            int expected = -1;
+            Reason.compare_exchange_strong(expected, static_cast<int>(reason));
+            Source.request_stop();
+        }
+
+        void OnFinished() {
+            // Counted and reported under one lock, so the last task only completes the promise
+            // after every earlier progress call has returned
+            size_t finished = 0;
+            {
+                std::lock_guard lock(Mutex);
+                finished = ++FinishedTasks;
+                if (Options.Progress) {
+                    Options.Progress(finished, TotalTasks, static_cast<double>(finished) / TotalTasks);
+                }
+            }
+            if (finished != TotalTasks) return;
+
+            if (!Exceptions.empty()) {
+                if (Aggregate) {
+                    Promise.set_exception(std::make_exception_ptr(AggregateException(std::move(Exceptions))));
                 }
-                for (int i = static_cast<int>(futures.size()) - 1; i >= 0; i--) {
-                    if (futures[i].wait_for(0ms) == std::future_status::ready) {
-                        results.emplace_back(futures[i].get());
-                        std::swap(futures[i], futures.back());
-                        futures.pop_back();
-                        finishedTasks++;
-                        if (progressCallback) {
-                            progressCallback(finishedTasks, totalTasks, static_cast<double>(finishedTasks) / totalTasks);
+                else {
+                    Promise.set_exception(Exceptions.front());
+                }
+            }
+            else if (Source.stop_requested()) {
+                Promise.set_exception(std::make_exception_ptr(OperationCancelled(static_cast<CancelReason>(Reason.load()))));
+            }
+            else if constexpr (std::is_void_v<ReturnType>) {
+                Promise.set_value();
+            }
+            else {
+                Promise.set_value(Results.Take());
+            }
+        }
+
+        std::mutex Mutex;
+        Storage Results;
+        std::vector<std::exception_ptr> Exceptions{};
+        size_t FinishedTasks{ 0 };
+        size_t TotalTasks{ 0 };
+        WhenAllOptions Options;
+        bool Aggregate{ false };
+
+        std::stop_source Source{};
+        std::atomic<int> Reason{ -1 };
+        std::stop_callback<StopRequested> ExternalStop;
+        std::jthread Watchdog{};
+    };
+
+    template<typename Range, typename Func, typename ReturnType>
+    struct ParallelMapState {
+        ParallelMapState(Range& range, Func& func, size_t chunkSize)
+            : Items(range)
+            , Mapper(func)
+            , ChunkSize(chunkSize)
+            , ChunkCount((std::ranges::size(range) + chunkSize - 1) / chunkSize)
+            , Results(std::ranges::size(range))
+        {}
+
+        // Claims chunks until none are left.  Only dereferences the range and func after a
+        // successful claim, so helpers which start after the caller returned never touch them.
+        // After a failure the remaining chunks are still claimed but skipped.
+        void Drain() {
+            while (true) {
+                auto chunk = NextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= ChunkCount) return;
+
+                if (!Failed.load(std::memory_order_relaxed)) {
+                    auto begin = chunk * ChunkSize;
+                    auto end = std::min(begin + ChunkSize, Results.Size());
+                    try {
+                        auto it = std::ranges::begin(Items) + begin;
+                        for (auto i = begin; i < end; i++, ++it) {
+                            Results.Set(i, std::invoke(Mapper, *it));
                         }
                     }
+                    catch (...) {
+                        std::lock_guard lock(Mutex);
+                        if (!FirstException) {
+                            FirstException = std::current_exception();
+                        }
+                        Failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+
+                if (CompletedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == ChunkCount) {
+                    CompletedChunks.notify_all();
                 }
             }
-            return results;
         }
-    });
-}
\ No newline at end of file
+
+        void Wait() {
+            auto completed = CompletedChunks.load(std::memory_order_acquire);
+            while (completed < ChunkCount) {
+                CompletedChunks.wait(completed, std::memory_order_acquire);
+                completed = CompletedChunks.load(std::memory_order_acquire);
+            }
+        }
+
+        Range& Items;
+        Func& Mapper;
+        size_t ChunkSize;
+        size_t ChunkCount;
+        OrderedResults<ReturnType> Results;
+
+        std::mutex Mutex;
+        std::exception_ptr FirstException{};
+        std::atomic<bool> Failed{ false };
+        std::atomic<size_t> NextChunk{ 0 };
+        std::atomic<size_t> CompletedChunks{ 0 };
+    };
+}
+
+namespace Threading::Detail {
+    template<typename Tasks>
+    auto StartWhenAll(Threading::ThreadPool& pool, Tasks tasks, WhenAllOptions options, bool aggregate) {
+        using ReturnType = TaskResult<typename Tasks::value_type>;
+        using State = WhenAllState<ReturnType>;
+
+        auto state = std::make_shared<State>(tasks.size(), std::move(options), aggregate);
+        auto future = state->Promise.get_future();
+        if (tasks.empty()) {
+            if constexpr (std::is_void_v<ReturnType>) {
+                state->Promise.set_value();
+            }
+            else {
+                state->Promise.set_value({});
+            }
+            return future;
+        }
+
+        state->StartWatchdog();
+        for (size_t i = 0u; i < tasks.size(); i++) {
+            pool.Post([state, i, task = std::move(tasks[i])]() mutable { state->Run(i, task); });
+        }
+        return future;
+    }
+}
+
+// Runs every task on the pool.  The returned future becomes ready once all tasks finish;
+// nothing polls in the meantime.  Results are in the same order as the tasks.
+// If any task throws, the first exception is rethrown from get().
+auto WhenAll(Threading::ThreadPool& pool, auto tasks, ProgressCallback progressCallback = nullptr) {
+    return Threading::Detail::StartWhenAll(pool, std::move(tasks), Threading::WhenAllOptions{
+        .CancelOnFailure = false,
+        .Progress = std::move(progressCallback)
+        }, false);
+}
+
+auto WhenAll(auto tasks, ProgressCallback progressCallback = nullptr) {
+    return WhenAll(Threading::ThreadPool::Default(), std::move(tasks), std::move(progressCallback));
+}
+
+// Cancellable variant.  Tasks may take a std::stop_token to notice cancellation while running,
+// tasks which haven't started yet when cancellation happens are skipped.
+// get() throws an AggregateException holding every failure, or OperationCancelled if the
+// stop token or deadline ended the work without any task failing.
+auto WhenAll(Threading::ThreadPool& pool, auto tasks, Threading::WhenAllOptions options) {
+    return Threading::Detail::StartWhenAll(pool, std::move(tasks), std::move(options), true);
+}
+
+auto WhenAll(auto tasks, Threading::WhenAllOptions options) {
+    return WhenAll(Threading::ThreadPool::Default(), std::move(tasks), std::move(options));
+}
+
+// Applies func to every element of range on the pool and returns the results in range order.
+// Elements are handed out in chunks of chunkSize (0 picks one based on the pool size) so cheap
+// functions don't pay per-element scheduling.  The calling thread works on chunks too, which
+// also makes it safe to call from inside a pool task.  Blocks until done, rethrows the first exception.
+template<std::ranges::random_access_range Range, typename Func>
+    requires std::ranges::sized_range<Range>
+auto ParallelMap(Threading::ThreadPool& pool, Range&& range, Func func, size_t chunkSize = 0) {
+    using ReturnType = std::invoke_result_t<Func&, std::ranges::range_reference_t<Range>>;
+    using State = Threading::Detail::ParallelMapState<std::remove_reference_t<Range>, Func, ReturnType>;
+
+    auto count = static_cast<size_t>(std::ranges::size(range));
+    if (count == 0) {
+        return std::vector<ReturnType>{};
+    }
+    if (chunkSize == 0) {
+        chunkSize = std::max(size_t(1), count / (pool.ThreadCount() * 4));
+    }
+
+    auto state = std::make_shared<State>(range, func, chunkSize);
+    auto helpers = std::min(pool.ThreadCount(), state->ChunkCount - 1);
+    for (size_t i = 0u; i < helpers; i++) {
+        pool.Post([state]() { state->Drain(); });
+    }
+
+    state->Drain();
+    state->Wait();
+    if (state->FirstException) {
+        std::rethrow_exception(state->FirstException);
+    }
+    return state->Results.Take();
+}
+
+template<std::ranges::random_access_range Range, typename Func>
+    requires std::ranges::sized_range<Range>
+auto ParallelMap(Range&& range, Func func, size_t chunkSize = 0) {
+    return ParallelMap(Threading::ThreadPool::Default(), std::forward<Range>(range), std::move(func), chunkSize);
+}
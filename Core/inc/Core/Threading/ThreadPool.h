@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Threading {
+    /*
+    Persistent pool of worker threads.  Each worker owns a deque of tasks:
+    it pushes and pops work at the back (LIFO, cache friendly), and idle workers
+    steal from the front of other workers' deques.  Workers sleep on a condition
+    variable when there is nothing to do, so an idle pool costs no CPU.
+
+    Tasks posted from a worker thread go to that worker's own deque, tasks posted
+    from outside the pool are distributed round-robin.
+
+    Note: a task which blocks waiting on other tasks from the same pool can
+    starve the pool if every worker ends up blocked.
+    */
+    class ThreadPool {
+    public:
+        using Task = std::move_only_function<void()>;
+
+        explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Shared pool sized from hardware_concurrency
+        static ThreadPool& Default();
+
+        // Exceptions escaping a posted task terminate the program (same as std::thread)
+        void Post(Task task);
+
+        template<typename Func>
+        auto Submit(Func&& func) -> std::future<std::invoke_result_t<std::decay_t<Func>>> {
+            using ReturnType = std::invoke_result_t<std::decay_t<Func>>;
+            std::packaged_task<ReturnType()> task(std::forward<Func>(func));
+            auto future = task.get_future();
+            Post([task = std::move(task)]() mutable { task(); });
+            return future;
+        }
+
+        size_t ThreadCount() const {
+            return m_Threads.size();
+        }
+
+        // True when called from one of this pool's workers
+        bool IsWorkerThread() const;
+
+    private:
+        struct Worker {
+            std::mutex Mutex;
+            std::deque<Task> Tasks;
+        };
+
+        void WorkerLoop(size_t index);
+        bool TryPopLocal(size_t index, Task& outTask);
+        bool TrySteal(size_t thief, Task& outTask);
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::vector<std::thread> m_Threads;
+
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCondition;
+        std::atomic<size_t> m_PendingCount{ 0 };
+        std::atomic<size_t> m_NextWorker{ 0 };
+        bool m_Stopping{ false };
+    };
+}
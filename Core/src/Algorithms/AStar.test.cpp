@@ -1,6 +1,68 @@
 #include "Core/Algorithms/AStar.h"
+#include "Core/Algorithms/FloodFill.h"
 
 namespace AStarTests {
+    // Like the State in AStar.h's advanced usage, hashable but not ordered
+    struct HashOnly {
+        RowCol Pos;
+        constexpr bool operator==(const HashOnly&) const = default;
+    };
+
+    // Neither ordered nor hashable
+    struct EqualityOnly {
+        RowCol Pos;
+        constexpr bool operator==(const EqualityOnly&) const = default;
+    };
+}
+
+namespace Constexpr {
+    template<>
+    struct Hasher<AStarTests::HashOnly> {
+        constexpr size_t operator()(const AStarTests::HashOnly& state) const {
+            return Hasher<RowCol>()(state.Pos);
+        }
+    };
+}
+
+namespace AStarTests {
+    static_assert(std::is_same_v<Constexpr::LookupSet<size_t>, Constexpr::FlatSet<size_t>>);
+    static_assert(std::is_same_v<Constexpr::LookupMap<HashOnly, HashOnly>, Constexpr::BigMap<HashOnly, HashOnly>>);
+    static_assert(std::is_same_v<Constexpr::LookupSet<EqualityOnly>, Constexpr::SmallSet<EqualityOnly>>);
+
+    // Every position of a 3x3 grid, neighbors are the positions next to it
+    template<typename T>
+    constexpr std::vector<T> GridNeighbors(const T& state) {
+        std::vector<T> result;
+        if (state.Pos.Row > 0) result.push_back({ RowCol{ state.Pos.Row - 1, state.Pos.Col } });
+        if (state.Pos.Row < 2) result.push_back({ RowCol{ state.Pos.Row + 1, state.Pos.Col } });
+        if (state.Pos.Col > 0) result.push_back({ RowCol{ state.Pos.Row, state.Pos.Col - 1 } });
+        if (state.Pos.Col < 2) result.push_back({ RowCol{ state.Pos.Row, state.Pos.Col + 1 } });
+        return result;
+    }
+
+    template<typename T>
+    constexpr bool AStarMin_WithUnorderedKey_FindsShortestPath() {
+        T start{ RowCol{ 0, 0 } };
+        T end{ RowCol{ 2, 2 } };
+
+        auto path = AStarMin<T>(start,
+            [](const T&, const T&) -> size_t { return 1; },
+            [&end](const T& state) { return state == end; },
+            [&end](const T& state) -> size_t { return MDistance(state.Pos, end.Pos); },
+            GridNeighbors<T>,
+            [](T&, T&) {});
+
+        return path.size() == 5 && path.front() == start && path.back() == end;
+    }
+
+    template<typename T>
+    constexpr bool FloodFill_WithUnorderedKey_FillsEveryPosition() {
+        return FloodFill(T{ RowCol{ 1, 1 } }, GridNeighbors<T>).size() == 9;
+    }
+
+    static_assert(FloodFill_WithUnorderedKey_FillsEveryPosition<HashOnly>());
+    static_assert(FloodFill_WithUnorderedKey_FillsEveryPosition<EqualityOnly>());
+
     bool RunTests() {
         Coord n1 = { 10, 0 };
         Coord n2 = { 2, 3 };
@@ -29,6 +91,9 @@ namespace AStarTests {
         if (path[2] != n4) return false;
         if (path[1] != n2) return false;
 
+        if (!AStarMin_WithUnorderedKey_FindsShortestPath<HashOnly>()) return false;
+        if (!AStarMin_WithUnorderedKey_FindsShortestPath<EqualityOnly>()) return false;
+
         return true;
     }
 }
\ No newline at end of file
@@ -166,6 +166,105 @@ namespace Constexpr {
             return map.erase(24) == 0;
         }
 
+        constexpr bool IndexOperator_PastCapacity_GrowsMap() {
+            BigMap<int, int, 100> map;
+            for (int i = 0; i < 1000; i++) {
+                map[i] = i * 2;
+            }
+
+            if (map.size() != 1000) return false;
+            for (int i = 0; i < 1000; i++) {
+                if (map.at(i) != i * 2) return false;
+            }
+            return true;
+        }
+
+        constexpr bool Erase_ManyValues_KeepsOtherValues() {
+            BigMap<int, int, 100> map;
+            for (int i = 0; i < 500; i++) {
+                map[i] = i;
+            }
+            for (int i = 0; i < 500; i += 2) {
+                if (map.erase(i) != 1) return false;
+            }
+
+            if (map.size() != 250) return false;
+            for (int i = 0; i < 500; i++) {
+                if (map.contains(i) != (i % 2 == 1)) return false;
+            }
+            return true;
+        }
+
+        constexpr bool Clear_ThenInsert_ContainsOnlyNewValues() {
+            BigMap<int, int, 100> map;
+            for (int i = 0; i < 100; i++) {
+                map[i] = i;
+            }
+            map.clear();
+            map[200] = 1;
+
+            if (map.size() != 1) return false;
+            if (map.contains(0)) return false;
+            return map.at(200) == 1;
+        }
+
+        constexpr bool CopyConstructor_WithValues_CopiesAllValues() {
+            BigMap<int, int, 100> map;
+            for (int i = 0; i < 100; i++) {
+                map[i] = i;
+            }
+            auto copy = map;
+            map[0] = 42;
+
+            if (copy.size() != 100) return false;
+            for (int i = 0; i < 100; i++) {
+                if (copy.at(i) != i) return false;
+            }
+            return true;
+        }
+
+        constexpr bool MoveAssignment_ThenReuseMovedFrom_StoresNewValues() {
+            BigMap<int, int, 100> map;
+            for (int i = 0; i < 100; i++) {
+                map[i] = i;
+            }
+            BigMap<int, int, 100> moved;
+            moved = std::move(map);
+            map.clear();
+            map[7] = 70;
+
+            auto constructed = std::move(moved);
+            moved[8] = 80;
+
+            if (map.size() != 1 || map.at(7) != 70) return false;
+            if (moved.size() != 1 || moved.at(8) != 80) return false;
+            if (constructed.size() != 100) return false;
+            for (int i = 0; i < 100; i++) {
+                if (constructed.at(i) != i) return false;
+            }
+            return true;
+        }
+
+        constexpr bool IndexOperator_WithAnyIntKey_StoresValue() {
+            BigMap<int, int, 100> map;
+            map[9919] = 1;
+            map[0] = 2;
+
+            if (map.size() != 2) return false;
+            if (map.contains(1)) return false;
+            return map.at(9919) == 1 && map.at(0) == 2;
+        }
+
+        constexpr bool IndexOperator_WithAnyStringKey_StoresValue() {
+            BigMap<std::string, int, 100> map;
+            map["SentinelString"] = 1;
+            map[""] = 2;
+
+            if (map.size() != 2) return false;
+            if (map.contains("a")) return false;
+            return map.at("SentinelString") == 1 && map.at("") == 2;
+        }
+
         constexpr bool RangeBasedFor_WithValues_TraversesAllValues() {
             BigMap<int, int, 100> map;
             map[1] = 1;
@@ -324,6 +423,70 @@ namespace Constexpr {
             queue.clear();
             return queue.is_empty();
         }
+
+        constexpr bool Pop_WhileWrappingAndGrowing_KeepsOrder() {
+            Queue<int> queue;
+            int next = 0;
+            for (int i = 0; i < 100; i++) {
+                queue.push(i * 2);
+                queue.push(i * 2 + 1);
+                if (queue.front() != next++) return false;
+                queue.pop();
+            }
+
+            if (queue.size() != 100) return false;
+            while (!queue.is_empty()) {
+                if (queue.front() != next++) return false;
+                queue.pop();
+            }
+            return next == 200;
+        }
+
+        constexpr bool PopRange_AfterPushRange_ReturnsOldestFirst() {
+            Queue<std::string> queue;
+            queue.push("a");
+            queue.push_range(std::vector<std::string>{ "b", "c", "d" });
+
+            auto popped = queue.pop_range(3);
+            return popped == std::vector<std::string>{ "a", "b", "c" } && queue.size() == 1 && queue.front() == "d";
+        }
+
+        constexpr bool Push_FrontOfFullQueue_CopiesBeforeGrowing() {
+            Queue<std::string> queue;
+            for (size_t i = 0; i < 8; i++) {
+                queue.push(std::string(i + 1, 'a'));
+            }
+            queue.push(queue.front());
+
+            for (size_t i = 0; i < 8; i++) {
+                queue.pop();
+            }
+            return queue.size() == 1 && queue.front() == "a";
+        }
+
+        constexpr bool Front_ThenPop_KeepsValue() {
+            Queue<std::string> queue;
+            queue.push("a");
+            auto front = queue.front();
+            queue.pop();
+            return front == "a" && queue.is_empty();
+        }
+
+        constexpr bool Push_WithoutDefaultConstructor_KeepsOrder() {
+            struct NoDefault {
+                constexpr NoDefault(int value) : Value(value) {}
+                int Value;
+            };
+            Queue<NoDefault> queue;
+            for (int i = 0; i < 20; i++) {
+                queue.push(NoDefault(i));
+            }
+            for (int i = 0; i < 20; i++) {
+                if (queue.front().Value != i) return false;
+                queue.pop();
+            }
+            return queue.is_empty();
+        }
     }
 
     namespace RingTests {
@@ -496,6 +659,106 @@ namespace Constexpr {
             Constexpr::BigSet<int, 100> set{42};
             return !set.contains(24);
         }
+
+        constexpr bool Insert_WithAnyKey_ContainsKey() {
+            Constexpr::BigSet<int, 100> set;
+            if (set.contains(0) || set.contains(9919)) return false;
+
+            set.insert(0);
+            set.insert(9919);
+            return set.size() == 2 && set.contains(0) && set.contains(9919);
+        }
+
+        constexpr bool CopyConstructor_WithElements_CopiesAllElements() {
+            Constexpr::BigSet<int, 100> set{1, 2, 3};
+            auto copy = set;
+            set.clear();
+
+            return copy.size() == 3 && copy.contains(1) && copy.contains(2) && copy.contains(3);
+        }
+
+        constexpr bool RangeBasedFor_WithElements_TraversesAllElements() {
+            Constexpr::BigSet<int, 100> set{1, 2, 3};
+            set.erase(2);
+
+            int sum = 0;
+            for (auto val : set) {
+                sum += val;
+            }
+            return sum == 4;
+        }
+    }
+
+    namespace FlatMapTests {
+        constexpr bool DefaultConstructor_CreatesEmptyMap() {
+            FlatMap<int, int> map;
+            return map.is_empty();
+        }
+
+        constexpr bool IndexOperator_WithMissingValue_InsertsDefaultValue() {
+            FlatMap<int, int> map;
+            return map[42] == 0 && map.size() == 1;
+        }
+
+        constexpr bool GetKeys_WhileFlat_ReturnsSortedKeys() {
+            FlatMap<int, int> map = { {3, 1}, {1, 2}, {2, 3} };
+            return map.GetKeys() == std::vector<int>{ 1, 2, 3 };
+        }
+
+        constexpr bool IndexOperator_PastPromoteAt_KeepsAllValues() {
+            FlatMap<int, int, 8> map;
+            for (int i = 0; i < 100; i++) {
+                map[i] = i * 2;
+            }
+            if (map.erase(50) != 1) return false;
+
+            if (map.size() != 99) return false;
+            for (int i = 0; i < 100; i++) {
+                if (map.contains(i) != (i != 50)) return false;
+                if (i != 50 && map.at(i) != i * 2) return false;
+            }
+            return true;
+        }
+
+        constexpr bool IndexOperator_WithUnhashableKey_StaysFlat() {
+            struct Key {
+                int Val;
+                constexpr bool operator<(const Key& other) const { return Val < other.Val; }
+                constexpr bool operator==(const Key& other) const = default;
+            };
+            FlatMap<Key, int, 8> map;
+            for (int i = 0; i < 100; i++) {
+                map[Key{ i }] = i;
+            }
+            return map.size() == 100 && map.at(Key{ 64 }) == 64;
+        }
+    }
+
+    namespace FlatSetTests {
+        constexpr bool InitializationListConstructor_IteratesInOrder() {
+            Constexpr::FlatSet<int> set{ 3, 1, 2, 1 };
+            std::vector<int> values(set.begin(), set.end());
+            return values == std::vector<int>{ 1, 2, 3 };
+        }
+
+        constexpr bool Insert_ExistingElement_ReturnsFalse() {
+            Constexpr::FlatSet<int> set{ 42 };
+            return !set.insert(42);
+        }
+
+        constexpr bool Insert_PastPromoteAt_ContainsAllElements() {
+            Constexpr::FlatSet<int, 8> set;
+            for (int i = 0; i < 100; i++) {
+                set.insert(i);
+            }
+            set.erase(50);
+
+            if (set.size() != 99) return false;
+            for (int i = 0; i < 100; i++) {
+                if (set.contains(i) != (i != 50)) return false;
+            }
+            return true;
+        }
     }
 
     namespace PriorityQueueTests {
@@ -584,6 +847,13 @@ namespace Constexpr {
         static_assert(BigMapTests::IndexOperator_WithMissingValue_InsertsDefaultValue());
         static_assert(BigMapTests::IndexOperator_WithNewValue_OverwritesOldValue());
         static_assert(BigMapTests::IndexOperator_WithValue_ReturnsMutableReference());
+        static_assert(BigMapTests::IndexOperator_PastCapacity_GrowsMap());
+        static_assert(BigMapTests::Erase_ManyValues_KeepsOtherValues());
+        static_assert(BigMapTests::Clear_ThenInsert_ContainsOnlyNewValues());
+        static_assert(BigMapTests::CopyConstructor_WithValues_CopiesAllValues());
+        static_assert(BigMapTests::MoveAssignment_ThenReuseMovedFrom_StoresNewValues());
+        static_assert(BigMapTests::IndexOperator_WithAnyIntKey_StoresValue());
+        static_assert(BigMapTests::IndexOperator_WithAnyStringKey_StoresValue());
         
 
         if (!BigMapTests::At_WithExistingElement_ReturnsValue()) return false;
@@ -595,6 +865,13 @@ namespace Constexpr {
         if (!BigMapTests::IndexOperator_WithMissingValue_InsertsDefaultValue()) return false;
         if (!BigMapTests::IndexOperator_WithNewValue_OverwritesOldValue()) return false;
         if (!BigMapTests::IndexOperator_WithValue_ReturnsMutableReference()) return false;
+        if (!BigMapTests::IndexOperator_PastCapacity_GrowsMap()) return false;
+        if (!BigMapTests::Erase_ManyValues_KeepsOtherValues()) return false;
+        if (!BigMapTests::Clear_ThenInsert_ContainsOnlyNewValues()) return false;
+        if (!BigMapTests::CopyConstructor_WithValues_CopiesAllValues()) return false;
+        if (!BigMapTests::MoveAssignment_ThenReuseMovedFrom_StoresNewValues()) return false;
+        if (!BigMapTests::IndexOperator_WithAnyIntKey_StoresValue()) return false;
+        if (!BigMapTests::IndexOperator_WithAnyStringKey_StoresValue()) return false;
 
         static_assert(StackTests::DefaultConstructor_CreatesValidStack());
         static_assert(StackTests::IsEmpty_AfterClearing_ReturnsTrue());
@@ -618,6 +895,11 @@ namespace Constexpr {
         static_assert(QueueTests::IsEmpty_OnEmptyQueue_ReturnsTrue());
         static_assert(QueueTests::IsEmpty_OnNonEmptyQueue_ReturnsFalse());
         static_assert(QueueTests::Push_OnEmptyQueue_HasSizeOne());
+        static_assert(QueueTests::Pop_WhileWrappingAndGrowing_KeepsOrder());
+        static_assert(QueueTests::PopRange_AfterPushRange_ReturnsOldestFirst());
+        static_assert(QueueTests::Push_FrontOfFullQueue_CopiesBeforeGrowing());
+        static_assert(QueueTests::Front_ThenPop_KeepsValue());
+        static_assert(QueueTests::Push_WithoutDefaultConstructor_KeepsOrder());
 
         if (!QueueTests::DefaultConstructor_CreatesValidQueue()) return false;
         if (!QueueTests::Front_WithElements_DoesNotRemoveElements()) return false;
@@ -627,6 +909,11 @@ namespace Constexpr {
         if (!QueueTests::IsEmpty_OnEmptyQueue_ReturnsTrue()) return false;
         if (!QueueTests::IsEmpty_OnNonEmptyQueue_ReturnsFalse()) return false;
         if (!QueueTests::Push_OnEmptyQueue_HasSizeOne()) return false;
+        if (!QueueTests::Pop_WhileWrappingAndGrowing_KeepsOrder()) return false;
+        if (!QueueTests::PopRange_AfterPushRange_ReturnsOldestFirst()) return false;
+        if (!QueueTests::Push_FrontOfFullQueue_CopiesBeforeGrowing()) return false;
+        if (!QueueTests::Front_ThenPop_KeepsValue()) return false;
+        if (!QueueTests::Push_WithoutDefaultConstructor_KeepsOrder()) return false;
 
         static_assert(RingTests::TestRing());
         static_assert(RingTests::TestVecRing());
@@ -665,11 +952,14 @@ namespace Constexpr {
         static_assert(BigSetTests::Empty_AfterClear_ReturnsTrue());
         static_assert(BigSetTests::Insert_NewElement_ReturnsTrue());
         static_assert(BigSetTests::Insert_ExistingElement_ReturnsFalse());
-        //static_assert(BigSetTests::InsertRange_InsertsNewElements());
+        static_assert(BigSetTests::InsertRange_InsertsNewElements());
         static_assert(BigSetTests::Erase_ExistingElement_RemovesElement());
         static_assert(BigSetTests::Erase_MissingElement_IsUnchanged());
         static_assert(BigSetTests::Contains_ExistingElement_ReturnsTrue());
         static_assert(BigSetTests::Contains_MissingElement_ReturnsFalse());
+        static_assert(BigSetTests::Insert_WithAnyKey_ContainsKey());
+        static_assert(BigSetTests::CopyConstructor_WithElements_CopiesAllElements());
+        static_assert(BigSetTests::RangeBasedFor_WithElements_TraversesAllElements());
 
         if(!BigSetTests::DefaultConstructor_CreatesEmptySet()) return false;
         if(!BigSetTests::InitializationListConstructor_CreatesSetWithElements()) return false;
@@ -682,6 +972,29 @@ namespace Constexpr {
         if(!BigSetTests::Erase_MissingElement_IsUnchanged()) return false;
         if(!BigSetTests::Contains_ExistingElement_ReturnsTrue()) return false;
         if (!BigSetTests::Contains_MissingElement_ReturnsFalse()) return false;
+        if (!BigSetTests::Insert_WithAnyKey_ContainsKey()) return false;
+        if (!BigSetTests::CopyConstructor_WithElements_CopiesAllElements()) return false;
+        if (!BigSetTests::RangeBasedFor_WithElements_TraversesAllElements()) return false;
+
+        static_assert(FlatMapTests::DefaultConstructor_CreatesEmptyMap());
+        static_assert(FlatMapTests::IndexOperator_WithMissingValue_InsertsDefaultValue());
+        static_assert(FlatMapTests::GetKeys_WhileFlat_ReturnsSortedKeys());
+        static_assert(FlatMapTests::IndexOperator_PastPromoteAt_KeepsAllValues());
+        static_assert(FlatMapTests::IndexOperator_WithUnhashableKey_StaysFlat());
+
+        if (!FlatMapTests::DefaultConstructor_CreatesEmptyMap()) return false;
+        if (!FlatMapTests::IndexOperator_WithMissingValue_InsertsDefaultValue()) return false;
+        if (!FlatMapTests::GetKeys_WhileFlat_ReturnsSortedKeys()) return false;
+        if (!FlatMapTests::IndexOperator_PastPromoteAt_KeepsAllValues()) return false;
+        if (!FlatMapTests::IndexOperator_WithUnhashableKey_StaysFlat()) return false;
+
+        static_assert(FlatSetTests::InitializationListConstructor_IteratesInOrder());
+        static_assert(FlatSetTests::Insert_ExistingElement_ReturnsFalse());
+        static_assert(FlatSetTests::Insert_PastPromoteAt_ContainsAllElements());
+
+        if (!FlatSetTests::InitializationListConstructor_IteratesInOrder()) return false;
+        if (!FlatSetTests::Insert_ExistingElement_ReturnsFalse()) return false;
+        if (!FlatSetTests::Insert_PastPromoteAt_ContainsAllElements()) return false;
 
         static_assert(PriorityQueueTests::Pop_AfterAdd_ReturnsValue());
         static_assert(PriorityQueueTests::Empty_OnNewQueue_ReturnsTrue());
@@ -0,0 +1,46 @@
+#include "Core/Instrumentation/Benchmark/ArgumentPool.h"
+#include "Core/Instrumentation/Benchmark/DoNotOptimize.h"
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+	constexpr size_t FallbackCacheSize = 32 * 1024 * 1024;
+}
+
+namespace Benchmark {
+#ifdef _MSC_VER
+	namespace Detail {
+		void UseCharPointer(const volatile char*) {}
+	}
+#endif
+
+	size_t LastLevelCacheSize() {
+		size_t largest = 0;
+#ifdef WIN32
+		DWORD bytes = 0;
+		GetLogicalProcessorInformation(nullptr, &bytes);
+		std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(bytes / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+		if (!info.empty() && GetLogicalProcessorInformation(info.data(), &bytes)) {
+			for (const auto& entry : info) {
+				if (entry.Relationship == RelationCache) {
+					largest = std::max(largest, static_cast<size_t>(entry.Cache.Size));
+				}
+			}
+		}
+#elif defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+		for (auto name : { _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE }) {
+			auto size = ::sysconf(name);
+			if (size > 0) largest = std::max(largest, static_cast<size_t>(size));
+		}
+#endif
+		return largest > 0 ? largest : FallbackCacheSize;
+	}
+}
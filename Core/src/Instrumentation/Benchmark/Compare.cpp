@@ -0,0 +1,118 @@
+#include "Core/Instrumentation/Benchmark/Compare.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+	f64 Median(std::vector<f64>& values) {
+		auto mid = values.begin() + values.size() / 2;
+		std::nth_element(values.begin(), mid, values.end());
+		return *mid;
+	}
+
+	// Normal approximation with tie correction, good enough from ~20 samples per side
+	f64 MannWhitneyPValue(std::span<const f64> baseline, std::span<const f64> candidate) {
+		struct Ranked {
+			f64 Value;
+			bool IsBaseline;
+		};
+		std::vector<Ranked> all;
+		all.reserve(baseline.size() + candidate.size());
+		for (auto value : baseline) all.push_back({ value, true });
+		for (auto value : candidate) all.push_back({ value, false });
+		std::sort(all.begin(), all.end(), [](const Ranked& lhs, const Ranked& rhs) { return lhs.Value < rhs.Value; });
+
+		const auto n1 = static_cast<f64>(baseline.size());
+		const auto n2 = static_cast<f64>(candidate.size());
+		const auto n = n1 + n2;
+
+		f64 baselineRanks = 0.0;
+		f64 tieTerm = 0.0;
+		for (size_t i = 0; i < all.size();) {
+			auto j = i;
+			while (j < all.size() && all[j].Value == all[i].Value) j++;
+
+			// Ties share the average of the ranks they span (ranks are 1 based)
+			auto rank = (static_cast<f64>(i + 1) + static_cast<f64>(j)) / 2.0;
+			for (auto k = i; k < j; k++) {
+				if (all[k].IsBaseline) baselineRanks += rank;
+			}
+			auto ties = static_cast<f64>(j - i);
+			tieTerm += ties * ties * ties - ties;
+			i = j;
+		}
+
+		auto u = baselineRanks - n1 * (n1 + 1) / 2.0;
+		auto mean = n1 * n2 / 2.0;
+		auto variance = n1 * n2 / 12.0 * ((n + 1) - tieTerm / (n * (n - 1)));
+		if (variance <= 0.0) return 1.0;
+
+		auto z = std::max(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+		return std::erfc(z / std::sqrt(2.0));
+	}
+}
+
+namespace Benchmark {
+	Comparison Compare(std::span<const f64> baseline, std::span<const f64> candidate, f64 confidence, u32 resamples) {
+		if (baseline.empty() || candidate.empty()) throw "Can not compare empty samples";
+		if (confidence <= 0.0 || confidence >= 1.0) throw "Confidence must be between 0 and 1";
+
+		Comparison result;
+		result.Confidence = confidence;
+
+		std::vector<f64> base(baseline.begin(), baseline.end());
+		std::vector<f64> cand(candidate.begin(), candidate.end());
+		result.BaselineMedian = Median(base);
+		result.CandidateMedian = Median(cand);
+		auto ratio = [](f64 baseMedian, f64 candMedian) {
+			return candMedian > 0.0 ? baseMedian / candMedian : std::numeric_limits<f64>::infinity();
+		};
+		result.Speedup = ratio(result.BaselineMedian, result.CandidateMedian);
+		result.PValue = MannWhitneyPValue(baseline, candidate);
+
+		if (resamples == 0) {
+			result.SpeedupLow = result.SpeedupHigh = result.Speedup;
+			return result;
+		}
+
+		// Percentile bootstrap of the median ratio
+		std::mt19937_64 random(0);
+		auto resampleMedian = [&](std::span<const f64> source, std::vector<f64>& scratch) {
+			std::uniform_int_distribution<size_t> pick(0, source.size() - 1);
+			for (auto& value : scratch) {
+				value = source[pick(random)];
+			}
+			return Median(scratch);
+		};
+
+		std::vector<f64> ratios(resamples);
+		for (auto& value : ratios) {
+			value = ratio(resampleMedian(baseline, base), resampleMedian(candidate, cand));
+		}
+		std::sort(ratios.begin(), ratios.end());
+
+		auto tail = (1.0 - confidence) / 2.0;
+		auto at = [&](f64 fraction) {
+			auto index = static_cast<size_t>(fraction * static_cast<f64>(ratios.size() - 1) + 0.5);
+			return ratios[std::min(index, ratios.size() - 1)];
+		};
+		result.SpeedupLow = at(tail);
+		result.SpeedupHigh = at(1.0 - tail);
+		return result;
+	}
+
+	std::string ToString(const Comparison& comparison) {
+		auto faster = comparison.Speedup >= 1.0;
+		auto factor = [&](f64 speedup) { return faster ? speedup : 1.0 / speedup; };
+		auto low = factor(faster ? comparison.SpeedupLow : comparison.SpeedupHigh);
+		auto high = factor(faster ? comparison.SpeedupHigh : comparison.SpeedupLow);
+
+		return std::format("{:.2f}x {} [{:.2f}x, {:.2f}x] (p = {:.4f}){}",
+			factor(comparison.Speedup), faster ? "faster" : "slower", low, high, comparison.PValue,
+			comparison.IsSignificant() ? "" : " not significant");
+	}
+}
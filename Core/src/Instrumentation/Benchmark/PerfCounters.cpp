@@ -0,0 +1,45 @@
+#include "Core/Instrumentation/Benchmark/PerfCounters.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include "PerfCounters_Linux.h"
+#else
+namespace PerfImpl {
+	// No counter backend on this platform, every counter is unavailable
+	struct EventGroup {
+		EventGroup(const std::vector<PerfCounter>&) {}
+		void Start() {}
+		void Stop() {}
+		void Read(std::span<u64>) {}
+
+		std::vector<PerfCounter> Available;
+	};
+}
+#endif
+
+PerfCounters::PerfCounters(const std::vector<PerfCounter>& counters)
+	: m_Group(std::make_unique<PerfImpl::EventGroup>(counters))
+{}
+
+PerfCounters::~PerfCounters() = default;
+
+const std::vector<PerfCounter>& PerfCounters::GetAvailable() const {
+	return m_Group->Available;
+}
+
+bool PerfCounters::IsAvailable(PerfCounter counter) const {
+	return std::find(m_Group->Available.begin(), m_Group->Available.end(), counter) != m_Group->Available.end();
+}
+
+void PerfCounters::Start() {
+	m_Group->Start();
+}
+
+void PerfCounters::Stop() {
+	m_Group->Stop();
+}
+
+void PerfCounters::Read(std::span<u64> outValues) const {
+	m_Group->Read(outValues);
+}
@@ -0,0 +1,94 @@
+#ifdef __linux__
+#include "Core/Instrumentation/Benchmark/PerfCounters.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace PerfImpl {
+	struct EventGroup {
+		EventGroup(const std::vector<PerfCounter>& counters) {
+			for (auto counter : counters) {
+				if (std::find(Available.begin(), Available.end(), counter) != Available.end()) continue;
+
+				auto file = Open(counter);
+				if (file < 0) continue;
+				if (m_Leader < 0) m_Leader = file;
+				m_Files.push_back(file);
+				Available.push_back(counter);
+			}
+
+			// PERF_FORMAT_GROUP reads as { nr, values[nr] }
+			m_Buffer.resize(m_Files.size() + 1);
+		}
+
+		~EventGroup() {
+			for (auto file : m_Files) {
+				::close(file);
+			}
+		}
+
+		void Start() {
+			if (m_Leader < 0) return;
+			::ioctl(m_Leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			::ioctl(m_Leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+
+		void Stop() {
+			if (m_Leader < 0) return;
+			::ioctl(m_Leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		}
+
+		void Read(std::span<u64> outValues) {
+			if (m_Leader < 0) return;
+
+			auto bytes = ::read(m_Leader, m_Buffer.data(), m_Buffer.size() * sizeof(u64));
+			if (bytes < static_cast<ssize_t>(sizeof(u64))) return;
+
+			auto count = std::min({ static_cast<size_t>(m_Buffer[0]), outValues.size(), m_Files.size() });
+			std::copy_n(m_Buffer.begin() + 1, count, outValues.begin());
+		}
+
+		std::vector<PerfCounter> Available;
+
+	private:
+		int Open(PerfCounter counter) const {
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.read_format = PERF_FORMAT_GROUP;
+			attr.exclude_hv = 1;
+			// Only the leader starts disabled, the rest of the group follows it
+			attr.disabled = m_Leader < 0 ? 1 : 0;
+
+			switch (counter) {
+			case PerfCounter::Cycles: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+			case PerfCounter::Instructions: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+			case PerfCounter::CacheMisses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+			case PerfCounter::BranchMisses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+			case PerfCounter::ContextSwitches: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES; break;
+			}
+
+			// pid 0, cpu -1: this thread on any cpu
+			auto open = [&]() {
+				return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, m_Leader, PERF_FLAG_FD_CLOEXEC));
+			};
+
+			auto file = open();
+			// perf_event_paranoid >= 2 only allows user space counting.  Context switches happen
+			// in the kernel, so a user space only count of them would always be 0.
+			if (file < 0 && attr.type == PERF_TYPE_HARDWARE) {
+				attr.exclude_kernel = 1;
+				file = open();
+			}
+			return file;
+		}
+
+		int m_Leader{ -1 };
+		std::vector<int> m_Files;
+		std::vector<u64> m_Buffer;
+	};
+}
+#endif
@@ -0,0 +1,88 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+
+#include <algorithm>
+#include <format>
+
+namespace Benchmark {
+	std::vector<s64> Range(s64 low, s64 high, s64 multiplier) {
+		if (low > high) throw "Range low must not be greater than high";
+		if (multiplier < 2) throw "Range multiplier must be at least 2";
+
+		std::vector<s64> result{ low };
+		for (auto value = std::max<s64>(low, 1); value <= high / multiplier;) {
+			value *= multiplier;
+			if (value < high) result.push_back(value);
+		}
+		if (high != low) result.push_back(high);
+		return result;
+	}
+
+	std::vector<s64> DenseRange(s64 low, s64 high, s64 step) {
+		if (step < 1) throw "DenseRange step must be positive";
+
+		std::vector<s64> result;
+		for (auto value = low; value <= high; value += step) {
+			result.push_back(value);
+		}
+		return result;
+	}
+
+	Registry& Registry::Get() {
+		static Registry instance{};
+		return instance;
+	}
+
+	void Registry::Add(std::string name, BenchmarkFunc func) {
+		m_Benchmarks.push_back({ std::move(name), std::move(func) });
+	}
+
+	void Registry::Add(const std::string& name, ParameterizedFunc func, const std::vector<s64>& args) {
+		for (auto arg : args) {
+			Add(std::format("{}/{}", name, arg), [func, arg](const Runner& runner) { return func(runner, arg); });
+		}
+	}
+
+	void Registry::AddScaling(std::string name, ScalingFunc func, std::vector<u32> threadCounts) {
+		m_Benchmarks.push_back({ std::move(name), nullptr, [func = std::move(func), threadCounts = std::move(threadCounts)](const Runner& runner) {
+			std::vector<Report> reports;
+			for (const auto& point : func(runner, threadCounts)) {
+				reports.push_back(MakeReport(std::to_string(point.Threads), point));
+			}
+			return reports;
+		} });
+	}
+
+	const std::vector<RegisteredBenchmark>& Registry::GetAll() const {
+		return m_Benchmarks;
+	}
+
+	std::vector<const RegisteredBenchmark*> Registry::Find(const std::regex& filter) const {
+		std::vector<const RegisteredBenchmark*> result;
+		for (const auto& benchmark : m_Benchmarks) {
+			if (std::regex_search(benchmark.Name, filter)) result.push_back(&benchmark);
+		}
+		return result;
+	}
+
+	std::vector<Report> Registry::RunAll(const Runner& runner) const {
+		return RunAll(runner, std::regex(""));
+	}
+
+	std::vector<Report> Registry::RunAll(const Runner& runner, const std::regex& filter) const {
+		std::vector<Report> reports;
+		for (const auto* benchmark : Find(filter)) {
+			if (benchmark->MultiFunc) {
+				for (auto& report : benchmark->MultiFunc(runner)) {
+					report.Name = std::format("{}/{}", benchmark->Name, report.Name);
+					reports.push_back(std::move(report));
+				}
+				continue;
+			}
+
+			auto report = benchmark->Func(runner);
+			report.Name = benchmark->Name;
+			reports.push_back(std::move(report));
+		}
+		return reports;
+	}
+}
@@ -0,0 +1,342 @@
+#include "Core/Instrumentation/Benchmark/Report.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+// Set by the build (Core/CMakeLists.txt)
+#ifndef DR_CXX_FLAGS
+#define DR_CXX_FLAGS ""
+#endif
+
+namespace {
+	std::string ReadFirstLine(const std::string& path) {
+		std::ifstream stream(path);
+		std::string line;
+		std::getline(stream, line);
+		return line;
+	}
+
+	std::string CpuModel() {
+#ifdef WIN32
+		char name[256]{};
+		DWORD size = sizeof(name);
+		if (RegGetValueA(HKEY_LOCAL_MACHINE, "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0", "ProcessorNameString", RRF_RT_REG_SZ, nullptr, name, &size) == ERROR_SUCCESS) {
+			return name;
+		}
+#elif defined(__linux__)
+		std::ifstream stream("/proc/cpuinfo");
+		std::string line;
+		while (std::getline(stream, line)) {
+			if (line.starts_with("model name") || line.starts_with("Model")) {
+				auto colon = line.find(':');
+				if (colon != std::string::npos && colon + 2 <= line.size()) return line.substr(colon + 2);
+			}
+		}
+#endif
+		return "Unknown";
+	}
+
+	std::string Compiler() {
+#if defined(__clang__)
+		return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+		return "GCC " __VERSION__;
+#elif defined(_MSC_VER)
+		return std::format("MSVC {}", _MSC_FULL_VER);
+#else
+		return "Unknown";
+#endif
+	}
+
+	std::string JsonString(std::string_view text) {
+		std::string result = "\"";
+		for (auto c : text) {
+			switch (c) {
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n"; break;
+			case '\r': result += "\\r"; break;
+			case '\t': result += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) result += std::format("\\u{:04x}", static_cast<int>(c));
+				else result += c;
+			}
+		}
+		return result + "\"";
+	}
+
+	// JSON has no inf or nan
+	std::string JsonNumber(f64 value) {
+		return std::isfinite(value) ? std::format("{}", value) : "null";
+	}
+
+	std::string JsonStats(const Stats& stats) {
+		return std::format(R"({{"unit": {}, "count": {}, "mean": {}, "median": {}, "min": {}, "max": {}, "stddev": {}, "p75": {}, "p90": {}, "p99": {}}})",
+			JsonString(stats.Unit), stats.Count, JsonNumber(stats.Mean), JsonNumber(stats.Median), JsonNumber(stats.Min), JsonNumber(stats.Max),
+			JsonNumber(stats.StdDev), JsonNumber(stats.Percent75), JsonNumber(stats.Percent90), JsonNumber(stats.Percent99));
+	}
+
+	std::string JsonNamedStats(const std::vector<std::pair<std::string, Stats>>& namedStats) {
+		std::string result = "{";
+		for (size_t i = 0; i < namedStats.size(); i++) {
+			if (i > 0) result += ", ";
+			result += JsonString(namedStats[i].first) + ": " + JsonStats(namedStats[i].second);
+		}
+		return result + "}";
+	}
+
+	std::string CsvField(const std::string& text) {
+		if (text.find_first_of(",\"\n") == std::string::npos) return text;
+
+		std::string result = "\"";
+		for (auto c : text) {
+			if (c == '"') result += '"';
+			result += c;
+		}
+		return result + "\"";
+	}
+
+	std::vector<std::string> SplitCsvLine(std::string_view line) {
+		std::vector<std::string> fields(1);
+		bool quoted = false;
+		for (size_t i = 0; i < line.size(); i++) {
+			auto c = line[i];
+			if (quoted) {
+				if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+					fields.back() += '"';
+					i++;
+				}
+				else if (c == '"') quoted = false;
+				else fields.back() += c;
+			}
+			else if (c == '"') quoted = true;
+			else if (c == ',') fields.emplace_back();
+			else fields.back() += c;
+		}
+		if (quoted) throw "Unterminated quote in csv";
+		return fields;
+	}
+
+	template<typename T>
+	T ParseNumber(const std::string& text) {
+		T value{};
+		auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		if (error != std::errc{} || end != text.data() + text.size()) throw "Invalid number in csv";
+		return value;
+	}
+
+	std::optional<f64> NanosPerUnit(const std::string& unit) {
+		if (unit == "ns") return 1.0;
+		if (unit == "us") return 1'000.0;
+		if (unit == "ms") return 1'000'000.0;
+		if (unit == "s") return 1'000'000'000.0;
+		return std::nullopt;
+	}
+
+	constexpr std::string_view LegacyCsvHeader = "name,unit,count,mean,median,min,max,stddev,p75,p90,p99,iterations,batch_size,low_outliers,high_outliers";
+	constexpr std::string_view CsvHeader = "name,unit,count,mean,median,min,max,stddev,p75,p90,p99,iterations,batch_size,low_outliers,high_outliers,samples";
+
+	// Space separated, at most MaxCsvSamples of them
+	std::string CsvSamples(const std::vector<f64>& samples) {
+		std::vector<f64> kept = samples;
+		if (kept.size() > Benchmark::MaxCsvSamples) {
+			std::sort(kept.begin(), kept.end());
+			std::vector<f64> quantiles(Benchmark::MaxCsvSamples);
+			for (size_t i = 0; i < quantiles.size(); i++) {
+				quantiles[i] = kept[(2 * i + 1) * kept.size() / (2 * quantiles.size())];
+			}
+			kept = std::move(quantiles);
+		}
+
+		std::string result;
+		for (size_t i = 0; i < kept.size(); i++) {
+			if (i > 0) result += ' ';
+			result += std::format("{}", kept[i]);
+		}
+		return result;
+	}
+
+	std::vector<f64> ParseSamples(const std::string& text) {
+		std::vector<f64> result;
+		std::istringstream stream(text);
+		std::string sample;
+		while (stream >> sample) {
+			result.push_back(ParseNumber<f64>(sample));
+		}
+		return result;
+	}
+
+	// Samples converted to nanoseconds
+	std::vector<f64> ScaledSamples(const std::vector<f64>& samples, f64 factor) {
+		std::vector<f64> result(samples.size());
+		std::transform(samples.begin(), samples.end(), result.begin(), [&](f64 sample) { return sample * factor; });
+		return result;
+	}
+}
+
+namespace Benchmark {
+	Environment CaptureEnvironment() {
+		return {
+			.CpuModel = CpuModel(),
+			.LogicalCores = std::thread::hardware_concurrency(),
+#ifdef __linux__
+			.Governor = ReadFirstLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor"),
+#else
+			.Governor = "",
+#endif
+			.Compiler = Compiler(),
+#ifdef DEBUG
+			.BuildType = "Debug",
+#else
+			.BuildType = "Release",
+#endif
+			.CompilerFlags = DR_CXX_FLAGS,
+			.Time = std::chrono::system_clock::now()
+		};
+	}
+
+	Report MakeReport(std::string name, const ScalingPoint& point) {
+		return {
+			.Name = std::move(name),
+			.RuntimeStats = point.Latency,
+			.MonitorStats = {},
+			.CounterStats = {},
+			.Ipc = std::nullopt,
+			.Iterations = point.Iterations,
+			.BatchSize = 1,
+			.LowOutliers = 0,
+			.HighOutliers = 0,
+			.Throughput = point.Throughput,
+			.Efficiency = point.Efficiency,
+			.Samples = {}
+		};
+	}
+
+	Report MakeReport(const ScalingPoint& point) {
+		return MakeReport("", point);
+	}
+
+	std::string ToJson(const Environment& environment, const std::vector<Report>& reports) {
+		std::ostringstream stream;
+		stream << "{\n  \"environment\": {"
+			<< "\"cpu\": " << JsonString(environment.CpuModel)
+			<< ", \"logical_cores\": " << environment.LogicalCores
+			<< ", \"governor\": " << JsonString(environment.Governor)
+			<< ", \"compiler\": " << JsonString(environment.Compiler)
+			<< ", \"build_type\": " << JsonString(environment.BuildType)
+			<< ", \"flags\": " << JsonString(environment.CompilerFlags)
+			<< ", \"time\": " << JsonString(std::format("{:%FT%TZ}", std::chrono::time_point_cast<std::chrono::seconds>(environment.Time)))
+			<< "},\n  \"benchmarks\": [";
+
+		for (size_t i = 0; i < reports.size(); i++) {
+			const auto& report = reports[i];
+			stream << (i > 0 ? ",\n    {" : "\n    {")
+				<< "\"name\": " << JsonString(report.Name)
+				<< ", \"iterations\": " << report.Iterations
+				<< ", \"batch_size\": " << report.BatchSize
+				<< ", \"low_outliers\": " << report.LowOutliers
+				<< ", \"high_outliers\": " << report.HighOutliers
+				<< ", \"runtime\": " << JsonStats(report.RuntimeStats)
+				<< ", \"monitors\": " << JsonNamedStats(report.MonitorStats)
+				<< ", \"counters\": " << JsonNamedStats(report.CounterStats)
+				<< ", \"ipc\": " << (report.Ipc ? JsonStats(*report.Ipc) : "null")
+				<< ", \"throughput\": " << (report.Throughput ? JsonNumber(*report.Throughput) : "null")
+				<< ", \"efficiency\": " << (report.Efficiency ? JsonNumber(*report.Efficiency) : "null")
+				<< "}";
+		}
+		stream << (reports.empty() ? "]\n}\n" : "\n  ]\n}\n");
+		return stream.str();
+	}
+
+	std::string ToCsv(const std::vector<Report>& reports) {
+		std::string result(CsvHeader);
+		result += '\n';
+		for (const auto& report : reports) {
+			const auto& stats = report.RuntimeStats;
+			result += std::format("{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}\n",
+				CsvField(report.Name), CsvField(stats.Unit), stats.Count, stats.Mean, stats.Median, stats.Min, stats.Max,
+				stats.StdDev, stats.Percent75, stats.Percent90, stats.Percent99,
+				report.Iterations, report.BatchSize, report.LowOutliers, report.HighOutliers, CsvSamples(report.Samples));
+		}
+		return result;
+	}
+
+	std::vector<Report> ReadCsv(const std::string& csv) {
+		std::istringstream stream(csv);
+		std::string line;
+		if (!std::getline(stream, line)) throw "Not a benchmark csv";
+		auto header = line.substr(0, line.find_last_not_of('\r') + 1);
+		if (header != CsvHeader && header != LegacyCsvHeader) throw "Not a benchmark csv";
+		const size_t fieldCount = header == CsvHeader ? 16 : 15;
+
+		std::vector<Report> result;
+		while (std::getline(stream, line)) {
+			if (!line.empty() && line.back() == '\r') line.pop_back();
+			if (line.empty()) continue;
+
+			auto fields = SplitCsvLine(line);
+			if (fields.size() != fieldCount) throw "Wrong number of fields in benchmark csv";
+
+			Report report;
+			report.Name = fields[0];
+			auto& stats = report.RuntimeStats;
+			stats.Unit = fields[1];
+			stats.Count = ParseNumber<size_t>(fields[2]);
+			stats.Mean = ParseNumber<f64>(fields[3]);
+			stats.Median = ParseNumber<f64>(fields[4]);
+			stats.Min = ParseNumber<f64>(fields[5]);
+			stats.Max = ParseNumber<f64>(fields[6]);
+			stats.StdDev = ParseNumber<f64>(fields[7]);
+			stats.Percent75 = ParseNumber<f64>(fields[8]);
+			stats.Percent90 = ParseNumber<f64>(fields[9]);
+			stats.Percent99 = ParseNumber<f64>(fields[10]);
+			report.Iterations = ParseNumber<u64>(fields[11]);
+			report.BatchSize = ParseNumber<u64>(fields[12]);
+			report.LowOutliers = ParseNumber<size_t>(fields[13]);
+			report.HighOutliers = ParseNumber<size_t>(fields[14]);
+			if (fieldCount > 15) report.Samples = ParseSamples(fields[15]);
+			result.push_back(std::move(report));
+		}
+		return result;
+	}
+
+	std::vector<Regression> FindRegressions(const std::vector<Report>& baseline, const std::vector<Report>& current, f64 threshold, f64 confidence) {
+		std::vector<Regression> result;
+		for (const auto& report : current) {
+			auto match = std::find_if(baseline.begin(), baseline.end(), [&](const Report& old) { return old.Name == report.Name; });
+			if (match == baseline.end()) continue;
+
+			auto baselineFactor = NanosPerUnit(match->RuntimeStats.Unit);
+			auto currentFactor = NanosPerUnit(report.RuntimeStats.Unit);
+			if (!baselineFactor || !currentFactor) continue;
+
+			auto baselineMedian = match->RuntimeStats.Median * *baselineFactor;
+			auto currentMedian = report.RuntimeStats.Median * *currentFactor;
+			if (baselineMedian <= 0.0) continue;
+
+			auto change = (currentMedian - baselineMedian) / baselineMedian;
+			if (change <= threshold) continue;
+
+			std::optional<f64> pValue;
+			if (!match->Samples.empty() && !report.Samples.empty()) {
+				auto baselineSamples = ScaledSamples(match->Samples, *baselineFactor);
+				auto currentSamples = ScaledSamples(report.Samples, *currentFactor);
+				auto comparison = Compare(baselineSamples, currentSamples, confidence);
+				if (!comparison.IsSignificant()) continue;
+				pValue = comparison.PValue;
+			}
+			result.push_back({ .Name = report.Name, .BaselineMedian = baselineMedian, .CurrentMedian = currentMedian, .Change = change, .PValue = pValue });
+		}
+		return result;
+	}
+}
@@ -1,55 +1,131 @@
 #ifdef __linux__
 #include "Core/Instrumentation/Benchmark/Stats.h"
 
-//without having a linux environment to test with,
-//I didn't want to try an implementation.
-//Check these resources:
-//https://stackoverflow.com/questions/669438/how-to-get-memory-usage-at-runtime-using-c
-//https://stackoverflow.com/questions/63166/how-to-determine-cpu-and-memory-consumption-from-inside-a-process/
-//https://pubs.opengroup.org/onlinepubs/9699919799/basedefs/sys_resource.h.html
-
-#include "sys/types.h"
-#include "sys/sysinfo.h"
-#include "sys/resource.h"
+#include <fcntl.h>
+#include <sys/resource.h>
 #include <unistd.h>
-#include <fstream>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <string_view>
 
 namespace ResourceImpl {
+	// Keeps a /proc file open between samples, each Read is a single pread from the start.
+	// Parsing is done with from_chars on the raw buffer to keep sampling cheap.
+	struct ProcFile {
+		explicit ProcFile(const char* path) : m_File(::open(path, O_RDONLY | O_CLOEXEC)) {
+			if (m_File < 0) throw "Failed to open proc file";
+		}
+		~ProcFile() {
+			::close(m_File);
+		}
+		ProcFile(const ProcFile&) = delete;
+		ProcFile& operator=(const ProcFile&) = delete;
+
+		std::string_view Read() {
+			auto bytes = ::pread(m_File, m_Buffer.data(), m_Buffer.size(), 0);
+			return bytes > 0 ? std::string_view(m_Buffer.data(), static_cast<size_t>(bytes)) : std::string_view{};
+		}
+
+	private:
+		int m_File{ -1 };
+		std::array<char, 1024> m_Buffer{};
+	};
+
+	// Returns the index-th (0 based) space separated number in the text, or 0 if there isn't one
+	inline u64 ParseField(std::string_view text, size_t index) {
+		size_t pos = 0;
+		for (size_t i = 0; i < index; i++) {
+			pos = text.find(' ', pos);
+			if (pos == std::string_view::npos) return 0;
+			pos++;
+		}
+
+		u64 value = 0;
+		std::from_chars(text.data() + pos, text.data() + text.size(), value);
+		return value;
+	}
+
 	struct PhysicalMemoryMonitor {
 		PhysicalMemoryMonitor(StatHolder& stats)
 			: Stats(stats)
-		{
-		}
+			, m_PageSize(static_cast<u64>(::sysconf(_SC_PAGESIZE)))
+		{}
 
+		// statm: size resident shared text lib data dt (in pages)
 		void Update() {
+			auto resident = ParseField(m_Statm.Read(), 1);
+			Stats.Add(static_cast<f64>(resident * m_PageSize));
 		}
 
 		StatHolder& Stats;
 	private:
+		ProcFile m_Statm{ "/proc/self/statm" };
+		u64 m_PageSize;
 	};
 
 	struct VirtualMemoryMonitor {
 		VirtualMemoryMonitor(StatHolder& stats)
 			: Stats(stats)
-		{
-		}
+		{}
 
+		// stat: pid (comm) state ... vsize is field 23.  comm may contain spaces and parentheses,
+		// so fields are counted from the last ')' where field 3 (state) starts.
 		void Update() {
+			auto text = m_Stat.Read();
+			auto commEnd = text.rfind(')');
+			if (commEnd == std::string_view::npos || commEnd + 2 >= text.size()) return;
+
+			constexpr size_t VSizeField = 23;
+			constexpr size_t StateField = 3;
+			auto vsize = ParseField(text.substr(commEnd + 2), VSizeField - StateField);
+			Stats.Add(static_cast<f64>(vsize));
 		}
 
 		StatHolder& Stats;
 	private:
+		ProcFile m_Stat{ "/proc/self/stat" };
 	};
 
+	// Fraction of the machine's CPU time used by this process since the previous sample
 	struct CpuMonitor {
-		CpuMonitor(StatHolder& stats) : Stats(stats) {
-		}
+		CpuMonitor(StatHolder& stats)
+			: Stats(stats)
+			, m_ProcCount(std::max(1l, ::sysconf(_SC_NPROCESSORS_ONLN)))
+			, m_PreviousCpu(ProcessCpuTime())
+			, m_PreviousTime(std::chrono::steady_clock::now())
+		{}
 
 		void Update() {
+			auto cpu = ProcessCpuTime();
+			auto now = std::chrono::steady_clock::now();
+
+			auto elapsed = std::chrono::duration<f64>(now - m_PreviousTime).count();
+			if (elapsed > 0.0) {
+				auto used = std::chrono::duration<f64>(cpu - m_PreviousCpu).count();
+				Stats.Add(used / elapsed / static_cast<f64>(m_ProcCount));
+			}
+
+			m_PreviousCpu = cpu;
+			m_PreviousTime = now;
 		}
 
 		StatHolder& Stats;
 	private:
+		static std::chrono::microseconds ProcessCpuTime() {
+			rusage usage{};
+			::getrusage(RUSAGE_SELF, &usage);
+			auto toMicros = [](const timeval& time) {
+				return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+			};
+			return toMicros(usage.ru_utime) + toMicros(usage.ru_stime);
+		}
+
+		long m_ProcCount;
+		std::chrono::microseconds m_PreviousCpu;
+		std::chrono::steady_clock::time_point m_PreviousTime;
 	};
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,27 @@
+#include "Core/Instrumentation/Benchmark/Scaling.h"
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Benchmark {
+	bool PinCurrentThread(u32 cpu) {
+#ifdef WIN32
+		if (cpu >= sizeof(DWORD_PTR) * 8) return false;
+		return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+		if (cpu >= CPU_SETSIZE) return false;
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+		(void)cpu;
+		return false;
+#endif
+	}
+}
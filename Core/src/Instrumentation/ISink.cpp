@@ -1,5 +1,5 @@
 #include "Core/Instrumentation/ISink.h"
-#include "Core/DesignPatterns/PubSub.h"
+#include "Core/DesignPatterns/ConcurrentPubSub.h"
 
 namespace Log {
 	Filter& Filter::WithLevel(Level level) {
@@ -7,21 +7,44 @@ namespace Log {
 		return *this;
 	}
 	Filter& Filter::WithFilePattern(const std::regex& pattern) {
-		m_FilePattern = pattern;
+		m_FilePattern = std::make_shared<FilePatternCache>(pattern);
 		return *this;
 	}
 
+	bool Filter::FilePatternCache::Matches(const char* fileName) {
+		{
+			std::shared_lock lock(Mutex);
+			if (auto it = Results.find(fileName); it != Results.end()) {
+				return it->second;
+			}
+		}
+
+		auto matches = std::regex_match(fileName, Pattern);
+		Evaluations.fetch_add(1, std::memory_order_relaxed);
+		std::unique_lock lock(Mutex);
+		Results.emplace(fileName, matches);
+		return matches;
+	}
+
 	Filter& Filter::WithCustomMatcher(std::function<bool(const Entry&)> matcher) {
 		m_CustomMatcher = matcher;
 		return *this;
 	}
 
+	Level Filter::MinLevel() const {
+		return m_Level.value_or(Level::Debug);
+	}
+
+	size_t Filter::FilePatternEvaluations() const {
+		return m_FilePattern ? m_FilePattern->Evaluations.load(std::memory_order_relaxed) : 0;
+	}
+
 	bool Filter::Matches(const Entry& entry) const {
 		if (m_Level.has_value() && m_Level.value() > entry.LogLevel) {
 			return false;
 		}
 
-		if (m_FilePattern.has_value() && !std::regex_match(entry.Context.FileName, m_FilePattern.value())) {
+		if (m_FilePattern && !m_FilePattern->Matches(entry.Context.FileName())) {
 			return false;
 		}
 		if (m_CustomMatcher.has_value() && !m_CustomMatcher.value()(entry)) {
@@ -33,7 +56,8 @@ namespace Log {
 	ISink::ISink(Filter filter)
 		: m_Filter(filter)
 	{
-		auto& services = ServiceLocator::Get().GetOrCreate<PubSub<Entry>>();
+		Detail::AddSinkLevel(m_Filter.MinLevel());
+		auto& services = ServiceLocator::Get().GetOrCreate<ConcurrentPubSub<Entry>>();
 
 		m_Handle = services.Subscribe([this](const Entry& entry) {
 			if (m_Filter.Matches(entry)) {
@@ -43,8 +67,17 @@ namespace Log {
 	}
 
 	ISink::~ISink() {
-		if (auto* ps = ServiceLocator::Get().Get<PubSub<Entry>>()) {
+		// Only a backstop, the derived sink has already unsubscribed
+		Unsubscribe();
+	}
+
+	void ISink::Unsubscribe() {
+		if (m_Handle == std::numeric_limits<size_t>::max()) return;
+
+		if (auto* ps = ServiceLocator::Get().Get<ConcurrentPubSub<Entry>>()) {
 			ps->Unsubscribe(m_Handle);
 		}
+		Detail::RemoveSinkLevel(m_Filter.MinLevel());
+		m_Handle = std::numeric_limits<size_t>::max();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Core/Platform/Types.h"
+
+#include <cstring>
+
+// On-disk layout shared by BinaryLogWriter and BinaryLogReader.  Values are stored in native byte order.
+//
+// Segment: Header, then records back to back.  The file is preallocated and zero filled, so a record
+// type of 0 marks the end of the data (the writer truncates the file to the used size when closing).
+//
+// Every segment is self contained: interned strings are defined again in each segment before their
+// first use, so old segments can be deleted without breaking the newer ones.
+namespace BinaryLogFormat {
+	constexpr u32 Magic = 0x4C425244; // "DRBL"
+	constexpr u16 Version = 1;
+	constexpr size_t HeaderSize = 8;
+
+	enum struct RecordType : u8 {
+		End = 0,
+		String = 1, // u32 id, u32 length, bytes
+		Entry = 2   // u8 level, u32 file id, u32 function id, u32 line, u64 thread, s64 time (ns since epoch), u32 length, bytes
+	};
+
+	constexpr size_t StringRecordSize = 1 + 4 + 4;
+	constexpr size_t EntryRecordSize = 1 + 1 + 4 + 4 + 4 + 8 + 8 + 4;
+
+	template<typename T>
+	void Put(char*& out, T value) {
+		std::memcpy(out, &value, sizeof(T));
+		out += sizeof(T);
+	}
+
+	template<typename T>
+	T Get(const char*& in) {
+		T value;
+		std::memcpy(&value, in, sizeof(T));
+		in += sizeof(T);
+		return value;
+	}
+}
@@ -0,0 +1,106 @@
+#include "Core/Instrumentation/LogWriter/BinaryLogReader.h"
+
+#include "BinaryLogFormat.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+	constexpr std::string_view ToString(Log::Level level) {
+		switch (level) {
+		case Log::Level::Debug: return "Debug";
+		case Log::Level::Info: return "Info";
+		case Log::Level::Warning: return "Warning";
+		case Log::Level::Error: return "Error";
+		}
+		return "Unknown";
+	}
+}
+
+namespace BinaryLogReader {
+	std::vector<Record> ReadSegment(const std::string& path) {
+		using namespace BinaryLogFormat;
+
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream) throw "Failed to open log segment";
+		std::vector<char> bytes{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+
+		const char* in = bytes.data();
+		const char* end = bytes.data() + bytes.size();
+		if (bytes.size() < HeaderSize || Get<u32>(in) != Magic) throw "Not a binary log segment";
+		if (Get<u16>(in) != Version) throw "Unsupported binary log version";
+		in = bytes.data() + HeaderSize;
+
+		auto remaining = [&]() { return static_cast<size_t>(end - in); };
+		auto readString = [&](u32 length) {
+			if (remaining() < length) throw "Truncated binary log record";
+			std::string result(in, length);
+			in += length;
+			return result;
+		};
+
+		std::unordered_map<u32, std::string> strings;
+		auto lookup = [&](u32 id) -> const std::string& {
+			auto it = strings.find(id);
+			if (it == strings.end()) throw "Binary log references an unknown string";
+			return it->second;
+		};
+
+		std::vector<Record> records;
+		while (remaining() > 0) {
+			auto type = static_cast<RecordType>(*in);
+			if (type == RecordType::End) break;
+
+			if (type == RecordType::String) {
+				if (remaining() < StringRecordSize) throw "Truncated binary log record";
+				in++;
+				auto id = Get<u32>(in);
+				auto length = Get<u32>(in);
+				strings[id] = readString(length);
+			}
+			else if (type == RecordType::Entry) {
+				if (remaining() < EntryRecordSize) throw "Truncated binary log record";
+				in++;
+				Record record;
+				record.LogLevel = static_cast<Log::Level>(Get<u8>(in));
+				record.FileName = lookup(Get<u32>(in));
+				record.Function = lookup(Get<u32>(in));
+				record.LineNumber = Get<u32>(in);
+				record.ThreadId = Get<u64>(in);
+				record.Time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(Get<s64>(in))));
+				record.Message = readString(Get<u32>(in));
+				records.push_back(std::move(record));
+			}
+			else {
+				throw "Corrupt binary log record";
+			}
+		}
+
+		return records;
+	}
+
+	std::vector<std::string> FindSegments(const std::string& directory, const std::string& baseName) {
+		std::vector<std::string> result;
+		auto prefix = baseName + ".";
+		for (const auto& file : std::filesystem::directory_iterator(directory)) {
+			auto name = file.path().filename().string();
+			if (file.is_regular_file() && name.starts_with(prefix) && name.ends_with(".drlog")) {
+				result.push_back(file.path().string());
+			}
+		}
+
+		// Indices are zero padded, so name order is write order
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	std::string ToString(const Record& record) {
+		auto time = std::chrono::time_point_cast<std::chrono::microseconds>(record.Time);
+		return std::format("{:%F %T} [{}] {}:{} ({}) [{:x}] - {}",
+			time, ::ToString(record.LogLevel), record.FileName, record.LineNumber, record.Function, record.ThreadId, record.Message);
+	}
+}
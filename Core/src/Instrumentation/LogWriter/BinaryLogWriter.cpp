@@ -0,0 +1,128 @@
+#include "Core/Instrumentation/LogWriter/BinaryLogWriter.h"
+
+#include "BinaryLogFormat.h"
+
+#ifdef WIN32
+#include "MappedSegment_Windows.h"
+#elif defined(__linux__)
+#include "MappedSegment_Linux.h"
+#else
+#error "Binary log writer not implemented for this platform"
+#endif
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <functional>
+
+namespace {
+	// Leaves room for the header and a reasonable number of records
+	constexpr size_t MinSegmentSize = 4096;
+}
+
+BinaryLogWriter::BinaryLogWriter(Log::Filter filter, Options options)
+	: ISink(filter)
+	, m_Options(std::move(options))
+{
+	m_Options.SegmentSize = std::max(m_Options.SegmentSize, MinSegmentSize);
+	std::filesystem::create_directories(m_Options.Directory);
+
+	std::lock_guard lock(m_Mutex);
+	OpenNextSegment();
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+	Unsubscribe();
+}
+
+std::deque<std::string> BinaryLogWriter::GetSegments() const {
+	std::lock_guard lock(m_Mutex);
+	return m_SegmentPaths;
+}
+
+void BinaryLogWriter::Write(const Log::Entry& entry) {
+	using namespace BinaryLogFormat;
+
+	std::lock_guard lock(m_Mutex);
+	if (!m_Segment) return;
+
+	const auto* file = entry.Context.FileName();
+	const auto* function = entry.Context.Function();
+	auto messageLength = entry.Message.size();
+
+	auto overhead = InternCost(file) + InternCost(function) + EntryRecordSize;
+	if (m_Used + overhead + messageLength > m_Segment->Size() && m_Used > HeaderSize) {
+		OpenNextSegment();
+		overhead = InternCost(file) + InternCost(function) + EntryRecordSize;
+	}
+
+	// Messages which can't fit in an empty segment are truncated
+	if (m_Used + overhead > m_Segment->Size()) return;
+	messageLength = std::min(messageLength, m_Segment->Size() - m_Used - overhead);
+
+	auto* out = m_Segment->Data() + m_Used;
+	auto fileId = Intern(file, out);
+	auto functionId = Intern(function, out);
+
+	Put(out, RecordType::Entry);
+	Put(out, static_cast<u8>(entry.LogLevel));
+	Put(out, fileId);
+	Put(out, functionId);
+	Put(out, static_cast<u32>(entry.Context.LineNumber));
+	Put(out, static_cast<u64>(std::hash<std::thread::id>{}(entry.Context.ThreadId)));
+	Put(out, static_cast<s64>(std::chrono::duration_cast<std::chrono::nanoseconds>(entry.Time.time_since_epoch()).count()));
+	Put(out, static_cast<u32>(messageLength));
+	std::memcpy(out, entry.Message.data(), messageLength);
+	out += messageLength;
+
+	m_Used = static_cast<size_t>(out - m_Segment->Data());
+	m_Segment->SetUsed(m_Used);
+}
+
+void BinaryLogWriter::OpenNextSegment() {
+	using namespace BinaryLogFormat;
+
+	m_Segment.reset();
+
+	auto fileName = std::format("{}.{:06}.drlog", m_Options.BaseName, m_NextSegmentIndex++);
+	auto path = (std::filesystem::path(m_Options.Directory) / fileName).string();
+	m_Segment = std::make_unique<BinaryLogImpl::MappedSegment>(path, m_Options.SegmentSize);
+
+	auto* out = m_Segment->Data();
+	Put(out, Magic);
+	Put(out, Version);
+	Put(out, u16(0));
+	m_Used = HeaderSize;
+	m_Segment->SetUsed(m_Used);
+	m_InternedStrings.clear();
+
+	m_SegmentPaths.push_back(path);
+	while (m_Options.MaxSegments > 0 && m_SegmentPaths.size() > m_Options.MaxSegments) {
+		std::error_code ignored;
+		std::filesystem::remove(m_SegmentPaths.front(), ignored);
+		m_SegmentPaths.pop_front();
+	}
+}
+
+size_t BinaryLogWriter::InternCost(const char* str) const {
+	return m_InternedStrings.contains(str) ? 0 : BinaryLogFormat::StringRecordSize + std::strlen(str);
+}
+
+u32 BinaryLogWriter::Intern(const char* str, char*& out) {
+	using namespace BinaryLogFormat;
+
+	if (auto it = m_InternedStrings.find(str); it != m_InternedStrings.end()) {
+		return it->second;
+	}
+
+	auto id = static_cast<u32>(m_InternedStrings.size());
+	m_InternedStrings.emplace(str, id);
+
+	Put(out, RecordType::String);
+	Put(out, id);
+	auto length = std::strlen(str);
+	Put(out, static_cast<u32>(length));
+	std::memcpy(out, str, length);
+	out += length;
+	return id;
+}
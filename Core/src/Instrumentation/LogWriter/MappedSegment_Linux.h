@@ -0,0 +1,49 @@
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <string>
+
+namespace BinaryLogImpl {
+	class MappedSegment {
+	public:
+		MappedSegment(const std::string& path, size_t size) : m_Size(size) {
+			m_File = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (m_File < 0) throw "Failed to create log segment";
+
+			if (::ftruncate(m_File, static_cast<off_t>(size)) != 0) {
+				::close(m_File);
+				throw "Failed to size log segment";
+			}
+
+			auto* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+			if (mapped == MAP_FAILED) {
+				::close(m_File);
+				throw "Failed to map log segment";
+			}
+			m_Data = static_cast<char*>(mapped);
+		}
+
+		MappedSegment(const MappedSegment&) = delete;
+		MappedSegment& operator=(const MappedSegment&) = delete;
+
+		// Unmaps and shrinks the file to the bytes actually written
+		~MappedSegment() {
+			::munmap(m_Data, m_Size);
+			[[maybe_unused]] auto result = ::ftruncate(m_File, static_cast<off_t>(m_Used));
+			::close(m_File);
+		}
+
+		char* Data() { return m_Data; }
+		size_t Size() const { return m_Size; }
+		void SetUsed(size_t used) { m_Used = used; }
+
+	private:
+		int m_File{ -1 };
+		char* m_Data{ nullptr };
+		size_t m_Size{ 0 };
+		size_t m_Used{ 0 };
+	};
+}
+#endif
@@ -0,0 +1,57 @@
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include <string>
+
+namespace BinaryLogImpl {
+	class MappedSegment {
+	public:
+		MappedSegment(const std::string& path, size_t size) : m_Size(size) {
+			m_File = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (m_File == INVALID_HANDLE_VALUE) throw "Failed to create log segment";
+
+			LARGE_INTEGER mappingSize{};
+			mappingSize.QuadPart = static_cast<LONGLONG>(size);
+			m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READWRITE, mappingSize.HighPart, mappingSize.LowPart, nullptr);
+			if (!m_Mapping) {
+				CloseHandle(m_File);
+				throw "Failed to size log segment";
+			}
+
+			m_Data = static_cast<char*>(MapViewOfFile(m_Mapping, FILE_MAP_WRITE, 0, 0, size));
+			if (!m_Data) {
+				CloseHandle(m_Mapping);
+				CloseHandle(m_File);
+				throw "Failed to map log segment";
+			}
+		}
+
+		MappedSegment(const MappedSegment&) = delete;
+		MappedSegment& operator=(const MappedSegment&) = delete;
+
+		// Unmaps and shrinks the file to the bytes actually written
+		~MappedSegment() {
+			UnmapViewOfFile(m_Data);
+			CloseHandle(m_Mapping);
+
+			LARGE_INTEGER used{};
+			used.QuadPart = static_cast<LONGLONG>(m_Used);
+			SetFilePointerEx(m_File, used, nullptr, FILE_BEGIN);
+			SetEndOfFile(m_File);
+			CloseHandle(m_File);
+		}
+
+		char* Data() { return m_Data; }
+		size_t Size() const { return m_Size; }
+		void SetUsed(size_t used) { m_Used = used; }
+
+	private:
+		HANDLE m_File{ INVALID_HANDLE_VALUE };
+		HANDLE m_Mapping{ nullptr };
+		char* m_Data{ nullptr };
+		size_t m_Size{ 0 };
+		size_t m_Used{ 0 };
+	};
+}
+#endif
@@ -18,17 +18,21 @@ namespace {
 StdOutLogWriter::StdOutLogWriter(Log::Filter filter)
 	: ISink(filter) {}
 
+StdOutLogWriter::~StdOutLogWriter() {
+	Unsubscribe();
+}
+
 void StdOutLogWriter::Write(const Log::Entry& entry) {
     switch (entry.LogLevel) {
     case Log::Level::Debug:
-        std::printf(InfoLineFormat, "Debug", entry.Context.FileName.c_str(), entry.Context.LineNumber, entry.Message.c_str());
+        std::printf(InfoLineFormat, "Debug", entry.Context.FileName(), entry.Context.LineNumber, entry.Message.c_str());
         break;
 	case Log::Level::Info:
-		std::printf(InfoLineFormat, "Info", entry.Context.FileName.c_str(), entry.Context.LineNumber, entry.Message.c_str());
+		std::printf(InfoLineFormat, "Info", entry.Context.FileName(), entry.Context.LineNumber, entry.Message.c_str());
 		break;
 	case Log::Level::Warning:
 	case Log::Level::Error:
-		std::printf(ErrorLineFormat, entry.LogLevel == Log::Level::Warning ? "Warning" : "Error", entry.Context.FileName.c_str(), entry.Context.LineNumber, entry.Context.Function.c_str(), entry.Message.c_str());
+		std::printf(ErrorLineFormat, entry.LogLevel == Log::Level::Warning ? "Warning" : "Error", entry.Context.FileName(), entry.Context.LineNumber, entry.Context.Function(), entry.Message.c_str());
 		break;
 	}
 }
\ No newline at end of file
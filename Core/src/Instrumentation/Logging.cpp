@@ -1,63 +1,317 @@
 #include "Core/Instrumentation/Logging.h"
 
-#include "Core/DesignPatterns/PubSub.h"
+#include "Core/DesignPatterns/ConcurrentPubSub.h"
 #include "Core/DesignPatterns/ServiceLocator.h"
+#include "Core/Threading/BoundedQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace {
-    struct Store {
+    struct QueuedEntry {
+        Log::Entry Entry;
+        // Set for entries logged through Log::Write, runs on the writer thread
+        Log::Detail::Formatter Format{};
+    };
+
+    void Publish(const Log::Entry& entry) {
+        if (auto* pubSub = ServiceLocator::Get().Get<ConcurrentPubSub<Log::Entry>>()) {
+            pubSub->Publish(entry);
+        }
+    }
+
+    class AsyncWriter {
+    public:
+        // The service locator isn't thread safe, so the writer thread only ever sees the pub/sub it
+        // was handed here and never looks it up itself
+        AsyncWriter(Log::AsyncOptions options, ConcurrentPubSub<Log::Entry>& pubSub)
+            : m_Options(options)
+            , m_PubSub(pubSub)
+            , m_Queue(options.QueueCapacity)
+            , m_Thread([this]() { Run(); })
+        {}
+
+        ~AsyncWriter() {
+            {
+                std::lock_guard lock(m_WakeMutex);
+                m_Stopping = true;
+            }
+            m_WakeCondition.notify_one();
+            m_Thread.join();
+        }
+
+        void Push(QueuedEntry&& entry) {
+            // Reserved before pushing so Flush never sees a count which is missing queued entries
+            m_Reserved.fetch_add(1, std::memory_order_acq_rel);
+
+            while (!m_Queue.TryPush(std::move(entry))) {
+                switch (m_Options.Overflow) {
+                case Log::OverflowPolicy::Drop:
+                    m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                    MarkProcessed(1);
+                    return;
+                case Log::OverflowPolicy::DropOldest:
+                    if (m_Queue.TryPop()) {
+                        m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                        MarkProcessed(1);
+                    }
+                    break;
+                case Log::OverflowPolicy::Block:
+                    WaitForPop();
+                    break;
+                }
+            }
+
+            if (m_WriterIdle.load(std::memory_order_seq_cst)) {
+                WakeWriter();
+            }
+        }
+
         void Flush() {
-            auto copy = m_Logs;
-            m_Logs.clear();
+            // A sink which logs would otherwise wait on itself
+            if (std::this_thread::get_id() == m_Thread.get_id()) return;
+
+            auto target = m_Reserved.load(std::memory_order_acquire);
+            WakeWriter();
 
-            if(auto* pubSub = ServiceLocator::Get().Get<PubSub<Log::Entry>>()) {
-                for(const auto& log: copy) {
-                    pubSub->Publish(log);
+            auto processed = m_Processed.load(std::memory_order_acquire);
+            while (processed < target) {
+                m_Processed.wait(processed, std::memory_order_acquire);
+                processed = m_Processed.load(std::memory_order_acquire);
+            }
+        }
+
+        size_t Dropped() const {
+            return m_Dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void Run() {
+            auto batchSize = std::max(size_t(1), m_Options.BatchSize);
+            std::vector<QueuedEntry> batch;
+            batch.reserve(batchSize);
+
+            while (true) {
+                while (batch.size() < batchSize) {
+                    auto entry = m_Queue.TryPop();
+                    if (!entry) break;
+                    batch.push_back(std::move(*entry));
                 }
+
+                if (!batch.empty()) {
+                    m_Popped.fetch_add(batch.size(), std::memory_order_seq_cst);
+                    if (m_BlockedProducers.load(std::memory_order_seq_cst) > 0) {
+                        m_Popped.notify_all();
+                    }
+
+                    for (auto& queued : batch) {
+                        try {
+                            if (queued.Format) {
+                                queued.Entry.Message = queued.Format();
+                            }
+                            m_PubSub.Publish(queued.Entry);
+                        }
+                        catch (...) {
+                            // Nobody to report to on this thread, and dying here would hang Flush
+                        }
+                    }
+                    MarkProcessed(batch.size());
+                    batch.clear();
+                    continue;
+                }
+
+                std::unique_lock lock(m_WakeMutex);
+                if (m_Stopping && m_Queue.Empty()) break;
+
+                m_WriterIdle.store(true, std::memory_order_seq_cst);
+                // The timeout only guards against a missed wake up, producers notify when they see us idle
+                m_WakeCondition.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+                    return m_Stopping || !m_Queue.Empty();
+                });
+                m_WriterIdle.store(false, std::memory_order_relaxed);
             }
         }
 
-        void AddMessage(const Log::Entry& entry) {
-            //m_Logs.push_back(entry);
-            if(auto* listener = ServiceLocator::Get().Get<PubSub<Log::Entry>>()) {
-				listener->Publish(entry);
-			}
+        void WakeWriter() {
+            {
+                std::lock_guard lock(m_WakeMutex);
+            }
+            m_WakeCondition.notify_one();
         }
 
-        void WriteImmediate(const Log::Entry& entry) {
-            if(auto* listener = ServiceLocator::Get().Get<PubSub<Log::Entry>>()) {
-                listener->Publish(entry);
+        // Parks a producer which found the queue full until the writer pops
+        void WaitForPop() {
+            m_BlockedProducers.fetch_add(1, std::memory_order_seq_cst);
+            auto popped = m_Popped.load(std::memory_order_seq_cst);
+            // A pop since the failed push which emptied the queue would be the last one, otherwise
+            // the writer keeps popping and either sees us blocked or we see the new count
+            if (!m_Queue.Empty()) {
+                WakeWriter();
+                m_Popped.wait(popped, std::memory_order_acquire);
             }
+            m_BlockedProducers.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void MarkProcessed(size_t count) {
+            m_Processed.fetch_add(count, std::memory_order_acq_rel);
+            m_Processed.notify_all();
         }
 
-        private:
-            std::vector<Log::Entry> m_Logs{};
-        };
+        Log::AsyncOptions m_Options;
+        ConcurrentPubSub<Log::Entry>& m_PubSub;
+        Threading::BoundedQueue<QueuedEntry> m_Queue;
+
+        std::atomic<size_t> m_Reserved{ 0 };
+        std::atomic<size_t> m_Processed{ 0 };
+        std::atomic<size_t> m_Dropped{ 0 };
+        // Entries the writer has taken off the queue, blocked producers wait for it to change
+        std::atomic<size_t> m_Popped{ 0 };
+        std::atomic<size_t> m_BlockedProducers{ 0 };
+        std::atomic<bool> m_WriterIdle{ false };
+
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCondition;
+        bool m_Stopping{ false };
 
-    Store store;
+        std::thread m_Thread;
+    };
+
+    // Raw pointer for the logging fast path, ownership lives in AsyncStorage
+    std::atomic<AsyncWriter*> asyncWriter{ nullptr };
+
+    std::unique_ptr<AsyncWriter>& AsyncStorage() {
+        // The service locator has to outlive the writer, which drains into it when destroyed.
+        // Statics are destroyed in reverse order of construction, so make sure it exists first.
+        ServiceLocator::Get();
+        static std::unique_ptr<AsyncWriter> storage{};
+        return storage;
     }
 
-    namespace Log {
-        void Flush() {
-            store.Flush();
+    void Write(QueuedEntry&& queued) {
+        if (auto* async = asyncWriter.load(std::memory_order_acquire)) {
+            async->Push(std::move(queued));
+            return;
         }
 
-#ifndef FINAL
-        void Debug(const std::string& message, std::source_location loc) {
-            store.AddMessage({Level::Debug, message, Debug::Context(loc)});
+        if (queued.Format) {
+            queued.Entry.Message = queued.Format();
         }
-        void Info(const std::string& message, std::source_location loc) {
-            store.AddMessage({Level::Info, message, Debug::Context(loc)});
+        Publish(queued.Entry);
+    }
+
+    void WriteImmediate(QueuedEntry&& queued) {
+        if (auto* async = asyncWriter.load(std::memory_order_acquire)) {
+            async->Flush();
         }
-        void Warn(const std::string& message, std::source_location loc) {
-            store.AddMessage({Level::Warning, message, Debug::Context(loc)});
+
+        if (queued.Format) {
+            queued.Entry.Message = queued.Format();
+        }
+        Publish(queued.Entry);
+    }
+
+    void Dispatch(QueuedEntry&& queued) {
+        // Errors are written on the calling thread so asserts fire where they happen
+        if (queued.Entry.LogLevel == Log::Level::Error) {
+            WriteImmediate(std::move(queued));
+        }
+        else {
+            Write(std::move(queued));
+        }
+    }
+
+    std::mutex sinkLevelMutex;
+    std::array<size_t, 4> sinksAtLevel{};
+
+    void UpdateEnabledLevels() {
+        unsigned mask = 0;
+        bool anyBelow = false;
+        for (size_t level = 0u; level < sinksAtLevel.size(); level++) {
+            anyBelow |= sinksAtLevel[level] > 0;
+            if (anyBelow) mask |= 1u << level;
         }
-        void Error(const std::string& message, std::source_location loc) {
-            store.WriteImmediate({Level::Error, message, Debug::Context(loc)});
+        Log::Detail::EnabledLevels.store(mask, std::memory_order_relaxed);
+    }
+}
+
+namespace Log::Detail {
+    std::atomic<unsigned> EnabledLevels{ 0 };
+
+    void AddSinkLevel(Level minLevel) {
+        std::lock_guard lock(sinkLevelMutex);
+        sinksAtLevel[static_cast<size_t>(minLevel)]++;
+        UpdateEnabledLevels();
+    }
+
+    void RemoveSinkLevel(Level minLevel) {
+        std::lock_guard lock(sinkLevelMutex);
+        sinksAtLevel[static_cast<size_t>(minLevel)]--;
+        UpdateEnabledLevels();
+    }
+
+    void WriteDeferred(Level level, std::source_location loc, Formatter formatter) {
+        if (!IsEnabled(level)) return;
+        Dispatch({ Entry(level, {}, ::Debug::Context(loc)), std::move(formatter) });
+    }
+}
+
+namespace Log {
+    void EnableAsync(AsyncOptions options) {
+        DisableAsync();
+
+        auto& storage = AsyncStorage();
+        auto& pubSub = ServiceLocator::Get().GetOrCreate<ConcurrentPubSub<Log::Entry>>();
+        storage = std::make_unique<AsyncWriter>(options, pubSub);
+        asyncWriter.store(storage.get(), std::memory_order_release);
+    }
+
+    void DisableAsync() {
+        asyncWriter.store(nullptr, std::memory_order_release);
+        AsyncStorage().reset();
+    }
+
+    bool IsAsync() {
+        return asyncWriter.load(std::memory_order_acquire) != nullptr;
+    }
+
+    size_t DroppedCount() {
+        auto* async = asyncWriter.load(std::memory_order_acquire);
+        return async ? async->Dropped() : 0;
+    }
+
+    void Flush() {
+        if (auto* async = asyncWriter.load(std::memory_order_acquire)) {
+            async->Flush();
         }
+    }
+
+#ifndef FINAL
+    void Debug(const std::string& message, std::source_location loc) {
+        if (!IsEnabled(Level::Debug)) return;
+        Dispatch({ Entry(Level::Debug, message, Debug::Context(loc)) });
+    }
+    void Info(const std::string& message, std::source_location loc) {
+        if (!IsEnabled(Level::Info)) return;
+        Dispatch({ Entry(Level::Info, message, Debug::Context(loc)) });
+    }
+    void Warn(const std::string& message, std::source_location loc) {
+        if (!IsEnabled(Level::Warning)) return;
+        Dispatch({ Entry(Level::Warning, message, Debug::Context(loc)) });
+    }
+    void Error(const std::string& message, std::source_location loc) {
+        if (!IsEnabled(Level::Error)) return;
+        Dispatch({ Entry(Level::Error, message, Debug::Context(loc)) });
+    }
 #else
-        void Debug(const std::string& message, std::source_location loc) {}
-        void Info(const std::string& message, std::source_location loc) {}
-        void Warn(const std::string& message, std::source_location loc) {}
-        void Error(const std::string& message, std::source_location loc) {}
+    void Debug(const std::string& message, std::source_location loc) {}
+    void Info(const std::string& message, std::source_location loc) {}
+    void Warn(const std::string& message, std::source_location loc) {}
+    void Error(const std::string& message, std::source_location loc) {}
 #endif
-    }
\ No newline at end of file
+}
@@ -0,0 +1,189 @@
+#include "Core/Instrumentation/Metrics.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Metrics {
+	namespace Detail {
+		/*
+		One thread's samples for one metric.  The owning thread records into Histograms[Phase],
+		a drain flips Phase and then owns the other histogram once the owner is no longer busy
+		with it.  Both sides use seq_cst so that either the drain sees Busy set, or the recording
+		thread sees the new Phase and retries.
+		*/
+		struct Recorder {
+			explicit Recorder(const Histogram& layout) : Histograms{ layout, layout } {}
+
+			void Record(f64 value) {
+				while (true) {
+					auto phase = Phase.load(std::memory_order_seq_cst);
+					Busy.store(phase + 1, std::memory_order_seq_cst);
+					if (Phase.load(std::memory_order_seq_cst) == phase) {
+						Histograms[phase].Add(value);
+						Busy.store(0, std::memory_order_release);
+						return;
+					}
+				}
+			}
+
+			// Only one drain may run at a time
+			void DrainInto(Histogram& out) {
+				auto phase = Phase.load(std::memory_order_relaxed);
+				Phase.store(phase ^ 1, std::memory_order_seq_cst);
+				while (Busy.load(std::memory_order_seq_cst) == phase + 1) {
+					std::this_thread::yield();
+				}
+
+				out.Merge(Histograms[phase]);
+				Histograms[phase].Reset();
+			}
+
+			// Aligned so recorders of different threads never share a cache line
+			alignas(64) std::atomic<u32> Phase{ 0 };
+			std::atomic<u32> Busy{ 0 };
+			// Set by the owning thread when it exits, after its last record
+			std::atomic<bool> Orphaned{ false };
+			Histogram Histograms[2];
+		};
+	}
+
+	namespace {
+		std::atomic<size_t> nextMetricId{ 0 };
+
+		/*
+		This thread's recorders by Metric id.  The Metric owns them, so the ones of destroyed metrics
+		(and registries) are freed and pruned here.  While a metric is alive its recorder is too, so
+		Record can use the raw pointer.  Ids are never reused.
+		*/
+		struct ThreadRecorders {
+			struct Entry {
+				Detail::Recorder* Recorder;
+				std::weak_ptr<Detail::Recorder> Owner;
+			};
+
+			~ThreadRecorders() {
+				for (auto& [id, entry] : Entries) {
+					if (auto recorder = entry.Owner.lock()) {
+						recorder->Orphaned.store(true, std::memory_order_release);
+					}
+				}
+			}
+
+			void Add(size_t id, const std::shared_ptr<Detail::Recorder>& recorder) {
+				std::erase_if(Entries, [](const auto& pair) { return pair.second.Owner.expired(); });
+				Entries[id] = { recorder.get(), recorder };
+			}
+
+			std::unordered_map<size_t, Entry> Entries;
+		};
+
+		ThreadRecorders& GetThreadRecorders() {
+			thread_local ThreadRecorders recorders{};
+			return recorders;
+		}
+	}
+
+	Metric::Metric(std::string name, const Histogram& layout)
+		: m_Name(std::move(name))
+		, m_Layout(layout)
+		, m_Id(nextMetricId.fetch_add(1, std::memory_order_relaxed))
+	{}
+
+	Metric::~Metric() = default;
+
+	void Metric::Record(f64 value) {
+		GetRecorder().Record(value);
+	}
+
+	Detail::Recorder& Metric::GetRecorder() {
+		auto& recorders = GetThreadRecorders();
+		if (auto it = recorders.Entries.find(m_Id); it != recorders.Entries.end()) {
+			return *it->second.Recorder;
+		}
+
+		auto recorder = std::make_shared<Detail::Recorder>(m_Layout);
+		{
+			std::lock_guard lock(m_RecordersMutex);
+			m_Recorders.push_back(recorder);
+		}
+		recorders.Add(m_Id, recorder);
+		return *recorder;
+	}
+
+	Histogram Metric::Drain() {
+		Histogram result = m_Layout;
+
+		std::lock_guard lock(m_RecordersMutex);
+		for (auto& recorder : m_Recorders) {
+			recorder->DrainInto(result);
+		}
+
+		std::erase_if(m_Recorders, [&](const std::shared_ptr<Detail::Recorder>& recorder) {
+			if (!recorder->Orphaned.load(std::memory_order_acquire)) return false;
+			// Nothing records into the other histogram any more, flip back to drain it too
+			recorder->DrainInto(result);
+			return true;
+		});
+		return result;
+	}
+
+	Registry::Registry(Histogram layout)
+		: m_Layout(std::move(layout))
+	{
+		m_Layout.Reset();
+	}
+
+	Registry::~Registry() {
+		StopAggregator();
+	}
+
+	Metric& Registry::Get(const std::string& name) {
+		std::lock_guard lock(m_MetricsMutex);
+		auto it = std::find_if(m_Metrics.begin(), m_Metrics.end(), [&](const Metric& metric) { return metric.Name() == name; });
+		if (it != m_Metrics.end()) return *it;
+
+		m_Totals.push_back(m_Layout);
+		return m_Metrics.emplace_back(name, m_Layout);
+	}
+
+	Snapshot Registry::Collect() {
+		Snapshot snapshot{ .Time = std::chrono::system_clock::now(), .Metrics = {} };
+		{
+			std::lock_guard lock(m_MetricsMutex);
+			snapshot.Metrics.reserve(m_Metrics.size());
+			for (size_t i = 0; i < m_Metrics.size(); i++) {
+				auto interval = m_Metrics[i].Drain();
+				m_Totals[i].Merge(interval);
+				snapshot.Metrics.push_back({ .Name = m_Metrics[i].Name(), .Interval = std::move(interval), .Total = m_Totals[i] });
+			}
+		}
+
+		// Outside the lock so subscribers can use the registry
+		m_OnSnapshot.Publish(snapshot);
+		return snapshot;
+	}
+
+	void Registry::StartAggregator(std::chrono::milliseconds interval) {
+		if (m_Aggregator.joinable()) throw "Aggregator already started";
+
+		m_StopAggregator = false;
+		m_Aggregator = std::thread([this, interval]() {
+			std::unique_lock lock(m_AggregatorMutex);
+			while (!m_AggregatorSignal.wait_for(lock, interval, [this]() { return m_StopAggregator; })) {
+				lock.unlock();
+				Collect();
+				lock.lock();
+			}
+		});
+	}
+
+	void Registry::StopAggregator() {
+		if (!m_Aggregator.joinable()) return;
+		{
+			std::lock_guard lock(m_AggregatorMutex);
+			m_StopAggregator = true;
+		}
+		m_AggregatorSignal.notify_all();
+		m_Aggregator.join();
+	}
+}
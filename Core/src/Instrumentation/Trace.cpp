@@ -0,0 +1,250 @@
+#include "Core/Instrumentation/Trace.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define DR_TRACE_HAS_TSC
+#endif
+
+namespace Trace {
+	namespace Detail {
+		std::atomic<bool> Enabled{ false };
+
+		/*
+		Only the owning thread writes, export may read concurrently (e.g. an End after Stop).
+		Like a seqlock: the owner bumps Reserved before overwriting a slot and Head after, export
+		copies up to Head and then discards the slots Reserved shows were overwritten meanwhile.
+		*/
+		struct Event {
+			std::atomic<u64> Time{ 0 };
+			// nullptr for the end of the innermost open zone
+			std::atomic<const Trace::Zone*> Zone{ nullptr };
+		};
+
+		struct ThreadBuffer {
+			ThreadBuffer(size_t capacity, u32 id) : Events(capacity), Mask(capacity - 1), Id(id) {}
+
+			std::vector<Event> Events;
+			size_t Mask;
+			// Total events ever written, the next one goes to Events[Head & Mask]
+			alignas(64) std::atomic<u64> Head{ 0 };
+			std::atomic<u64> Reserved{ 0 };
+			// Head when the current trace started, guarded by the registry mutex
+			u64 TraceStart{ 0 };
+			u32 Id;
+			std::string Name;
+		};
+	}
+
+	namespace {
+		std::atomic<bool> useTsc{ false };
+
+		struct BufferRegistry {
+			std::mutex Mutex;
+			std::vector<std::shared_ptr<Detail::ThreadBuffer>> Buffers;
+			size_t Capacity{ Options{}.EventsPerThread };
+			u32 NextId{ 1 };
+			// When the trace started, in ticks and steady_clock time, for converting ticks to time
+			u64 StartTicks{ 0 };
+			std::chrono::steady_clock::time_point StartTime{};
+			bool StartUsedTsc{ false };
+		};
+
+		BufferRegistry& Registry() {
+			static BufferRegistry registry{};
+			return registry;
+		}
+
+		u64 SteadyNanos() {
+			return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		u64 Ticks() {
+#ifdef DR_TRACE_HAS_TSC
+			if (useTsc.load(std::memory_order_relaxed)) return __rdtsc();
+#endif
+			return SteadyNanos();
+		}
+
+		// Buffers only referenced from the registry belong to threads which have exited, they're
+		// kept while they hold events of the current trace.  Registry mutex must be held.
+		void ReclaimBuffers(BufferRegistry& registry) {
+			std::erase_if(registry.Buffers, [](const std::shared_ptr<Detail::ThreadBuffer>& buffer) {
+				return buffer.use_count() == 1 && buffer->Head.load(std::memory_order_acquire) == buffer->TraceStart;
+			});
+		}
+
+		std::shared_ptr<Detail::ThreadBuffer> CreateBuffer() {
+			auto& registry = Registry();
+			std::lock_guard lock(registry.Mutex);
+			ReclaimBuffers(registry);
+			auto buffer = std::make_shared<Detail::ThreadBuffer>(registry.Capacity, registry.NextId++);
+			registry.Buffers.push_back(buffer);
+			return buffer;
+		}
+
+		// Registered buffers outlive their threads so their events can still be exported
+		Detail::ThreadBuffer& ThreadBuffer() {
+			thread_local std::shared_ptr<Detail::ThreadBuffer> buffer = CreateBuffer();
+			return *buffer;
+		}
+
+		void Append(const Zone* zone) {
+			auto& buffer = ThreadBuffer();
+			auto head = buffer.Head.load(std::memory_order_relaxed);
+			auto& event = buffer.Events[head & buffer.Mask];
+			buffer.Reserved.store(head + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			event.Time.store(Ticks(), std::memory_order_relaxed);
+			event.Zone.store(zone, std::memory_order_relaxed);
+			buffer.Head.store(head + 1, std::memory_order_release);
+		}
+
+		struct CopiedEvent {
+			u64 Time;
+			const Trace::Zone* Zone;
+		};
+
+		// The events written since the trace started which are still in the buffer
+		std::vector<CopiedEvent> CopyEvents(const Detail::ThreadBuffer& buffer) {
+			auto head = buffer.Head.load(std::memory_order_acquire);
+			auto first = std::max(buffer.TraceStart, head > buffer.Events.size() ? head - buffer.Events.size() : 0);
+
+			std::vector<CopiedEvent> result;
+			result.reserve(head - first);
+			for (auto i = first; i < head; i++) {
+				const auto& event = buffer.Events[i & buffer.Mask];
+				result.push_back({ event.Time.load(std::memory_order_relaxed), event.Zone.load(std::memory_order_relaxed) });
+			}
+
+			// Slots the owner reached while copying hold newer events, drop them
+			std::atomic_thread_fence(std::memory_order_acquire);
+			auto reserved = buffer.Reserved.load(std::memory_order_relaxed);
+			if (reserved > first + buffer.Events.size()) {
+				auto overwritten = std::min<u64>(reserved - buffer.Events.size() - first, result.size());
+				result.erase(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(overwritten));
+			}
+			return result;
+		}
+
+		std::string JsonString(std::string_view text) {
+			std::string result = "\"";
+			for (auto c : text) {
+				switch (c) {
+				case '"': result += "\\\""; break;
+				case '\\': result += "\\\\"; break;
+				case '\n': result += "\\n"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20) result += std::format("\\u{:04x}", static_cast<int>(c));
+					else result += c;
+				}
+			}
+			return result + "\"";
+		}
+	}
+
+	namespace Detail {
+		void Begin(const Zone& zone) {
+			Append(&zone);
+		}
+
+		void End() {
+			Append(nullptr);
+		}
+	}
+
+	void Start(Options options) {
+		auto& registry = Registry();
+		std::lock_guard lock(registry.Mutex);
+		registry.Capacity = std::bit_ceil(std::max<size_t>(options.EventsPerThread, 2));
+#ifdef DR_TRACE_HAS_TSC
+		useTsc.store(options.UseTsc, std::memory_order_relaxed);
+#endif
+		registry.StartUsedTsc = useTsc.load(std::memory_order_relaxed);
+		registry.StartTicks = Ticks();
+		registry.StartTime = std::chrono::steady_clock::now();
+		for (auto& buffer : registry.Buffers) {
+			buffer->TraceStart = buffer->Head.load(std::memory_order_acquire);
+		}
+		ReclaimBuffers(registry);
+		Detail::Enabled.store(true, std::memory_order_release);
+	}
+
+	void Stop() {
+		Detail::Enabled.store(false, std::memory_order_release);
+	}
+
+	void SetThreadName(std::string name) {
+		auto& buffer = ThreadBuffer();
+		std::lock_guard lock(Registry().Mutex);
+		buffer.Name = std::move(name);
+	}
+
+	std::string ToChromeJson() {
+		auto& registry = Registry();
+		std::lock_guard lock(registry.Mutex);
+
+		// Ticks are nanoseconds unless they came from the TSC, whose rate is measured over the trace
+		f64 nanosPerTick = 1.0;
+		if (registry.StartUsedTsc) {
+			auto ticks = Ticks() - registry.StartTicks;
+			auto nanos = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - registry.StartTime).count();
+			if (ticks > 0) nanosPerTick = nanos / static_cast<f64>(ticks);
+		}
+		auto toMicros = [&](u64 ticks) {
+			auto sinceStart = static_cast<f64>(static_cast<s64>(ticks - registry.StartTicks));
+			return sinceStart * nanosPerTick / 1000.0;
+		};
+
+		std::string json = "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+		bool first = true;
+		auto append = [&](const std::string& event) {
+			json += first ? "\n" : ",\n";
+			json += event;
+			first = false;
+		};
+
+		for (const auto& buffer : registry.Buffers) {
+			auto events = CopyEvents(*buffer);
+			if (events.empty()) continue;
+
+			auto name = buffer->Name.empty() ? std::format("Thread {}", buffer->Id) : buffer->Name;
+			append(std::format(R"({{"ph": "M", "name": "thread_name", "pid": 1, "tid": {}, "args": {{"name": {}}}}})", buffer->Id, JsonString(name)));
+
+			// Complete events, matched with a stack since ends don't name their zone
+			std::vector<CopiedEvent> open;
+			auto close = [&](const CopiedEvent& begin, u64 endTime) {
+				auto start = toMicros(begin.Time);
+				append(std::format(R"({{"ph": "X", "name": {}, "cat": "zone", "pid": 1, "tid": {}, "ts": {:.3f}, "dur": {:.3f}, "args": {{"file": {}, "line": {}}}}})",
+					JsonString(begin.Zone->Name), buffer->Id, start, std::max(0.0, toMicros(endTime) - start), JsonString(begin.Zone->File), begin.Zone->Line));
+			};
+			for (const auto& event : events) {
+				if (event.Zone) {
+					open.push_back(event);
+				}
+				else if (!open.empty()) {
+					close(open.back(), event.Time);
+					open.pop_back();
+				}
+			}
+			while (!open.empty()) {
+				close(open.back(), events.back().Time);
+				open.pop_back();
+			}
+		}
+
+		json += "\n]}\n";
+		return json;
+	}
+}
@@ -0,0 +1,111 @@
+#include "Core/Threading/ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+    thread_local const Threading::ThreadPool* CurrentPool = nullptr;
+    thread_local size_t CurrentWorker = 0;
+}
+
+namespace Threading {
+    ThreadPool::ThreadPool(size_t threadCount) {
+        threadCount = std::max(size_t(1), threadCount);
+        m_Workers.reserve(threadCount);
+        for (size_t i = 0u; i < threadCount; i++) {
+            m_Workers.emplace_back(std::make_unique<Worker>());
+        }
+
+        m_Threads.reserve(threadCount);
+        for (size_t i = 0u; i < threadCount; i++) {
+            m_Threads.emplace_back([this, i]() { WorkerLoop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(m_WakeMutex);
+            m_Stopping = true;
+        }
+        m_WakeCondition.notify_all();
+        for (auto& thread : m_Threads) {
+            thread.join();
+        }
+    }
+
+    ThreadPool& ThreadPool::Default() {
+        static ThreadPool instance{};
+        return instance;
+    }
+
+    bool ThreadPool::IsWorkerThread() const {
+        return CurrentPool == this;
+    }
+
+    void ThreadPool::Post(Task task) {
+        auto index = IsWorkerThread()
+            ? CurrentWorker
+            : m_NextWorker.fetch_add(1, std::memory_order_relaxed) % m_Workers.size();
+
+        {
+            // Counted under the wake mutex so a worker can't miss the notification
+            // between checking the predicate and going to sleep.  Counted before the
+            // task is published so a worker running it can't take the count below zero.
+            std::lock_guard lock(m_WakeMutex);
+            m_PendingCount.fetch_add(1, std::memory_order_release);
+        }
+        {
+            auto& worker = *m_Workers[index];
+            std::lock_guard lock(worker.Mutex);
+            worker.Tasks.push_back(std::move(task));
+        }
+        m_WakeCondition.notify_one();
+    }
+
+    bool ThreadPool::TryPopLocal(size_t index, Task& outTask) {
+        auto& worker = *m_Workers[index];
+        std::lock_guard lock(worker.Mutex);
+        if (worker.Tasks.empty()) return false;
+
+        outTask = std::move(worker.Tasks.back());
+        worker.Tasks.pop_back();
+        return true;
+    }
+
+    bool ThreadPool::TrySteal(size_t thief, Task& outTask) {
+        for (size_t offset = 1u; offset < m_Workers.size(); offset++) {
+            auto& victim = *m_Workers[(thief + offset) % m_Workers.size()];
+            std::unique_lock lock(victim.Mutex, std::try_to_lock);
+            if (!lock.owns_lock() || victim.Tasks.empty()) continue;
+
+            outTask = std::move(victim.Tasks.front());
+            victim.Tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPool::WorkerLoop(size_t index) {
+        CurrentPool = this;
+        CurrentWorker = index;
+
+        Task task;
+        while (true) {
+            if (TryPopLocal(index, task) || TrySteal(index, task)) {
+                m_PendingCount.fetch_sub(1, std::memory_order_acq_rel);
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock lock(m_WakeMutex);
+            m_WakeCondition.wait(lock, [this]() {
+                return m_Stopping || m_PendingCount.load(std::memory_order_acquire) > 0;
+            });
+            if (m_Stopping && m_PendingCount.load(std::memory_order_acquire) == 0) {
+                break;
+            }
+        }
+
+        CurrentPool = nullptr;
+    }
+}
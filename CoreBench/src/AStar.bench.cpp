@@ -0,0 +1,44 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+#include "Core/Algorithms/AStar.h"
+
+namespace {
+	using Grid = std::vector<std::string>;
+
+	// Every fourth column is a wall with a gap alternating between the top and bottom row,
+	// so the path snakes through the whole grid instead of running along the diagonal
+	Grid MakeMaze(size_t size) {
+		Grid grid(size, std::string(size, '.'));
+		for (size_t col = 2; col < size; col += 4) {
+			auto gapRow = (col / 4) % 2 == 0 ? size - 1 : 0;
+			for (size_t row = 0; row < size; row++) {
+				if (row != gapRow) grid[row][col] = '#';
+			}
+		}
+		return grid;
+	}
+
+	std::vector<RowCol> OpenNeighbors(const Grid& grid, const RowCol& pos) {
+		auto neighbors = GetDirectNeighbors(pos, { grid.size() - 1, grid[0].size() - 1 });
+		std::erase_if(neighbors, [&](const RowCol& rc) { return grid[rc.Row][rc.Col] == '#'; });
+		return neighbors;
+	}
+}
+
+DR_BENCHMARK(AStarMaze, Benchmark::Range(16, 128, 2)) {
+	auto size = static_cast<size_t>(arg);
+	AStarParameters<RowCol, Grid> params{
+		.map = MakeMaze(size),
+		.start = { 0, 0 },
+		.end = { size - 1, size - 1 },
+		.nFunc = OpenNeighbors
+	};
+	return Benchmark::MakeReport(runner.Run([&]() { return AStarMin<1 << 15>(params); }));
+}
+
+// The default (not Big) containers, flat until they outgrow FlatMap's PromoteAt
+DR_BENCHMARK(AStarMazeFlat, Benchmark::Range(16, 128, 2)) {
+	auto size = static_cast<size_t>(arg);
+	auto grid = MakeMaze(size);
+	auto neighbors = [&grid](const RowCol& pos) { return OpenNeighbors(grid, pos); };
+	return Benchmark::MakeReport(runner.Run([&]() { return AStarMin<RowCol>({ 0, 0 }, { size - 1, size - 1 }, neighbors); }));
+}
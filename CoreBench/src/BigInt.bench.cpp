@@ -0,0 +1,35 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+#include "Core/BigInt.h"
+
+namespace {
+	// arg digits of 1..9 repeating
+	std::string MakeDigits(s64 digits) {
+		std::string result;
+		for (s64 i = 0; i < digits; i++) {
+			result += static_cast<char>('1' + i % 9);
+		}
+		return result;
+	}
+}
+
+DR_BENCHMARK(BigIntParse, Benchmark::Range(10, 1000, 10)) {
+	auto digits = MakeDigits(arg);
+	return Benchmark::MakeReport(runner.Run([&]() { return BigInt(digits); }));
+}
+
+DR_BENCHMARK(BigIntToString, Benchmark::Range(10, 1000, 10)) {
+	BigInt value(MakeDigits(arg));
+	return Benchmark::MakeReport(runner.Run([&]() { return value.ToString(); }));
+}
+
+DR_BENCHMARK(BigIntAdd, Benchmark::Range(10, 1000, 10)) {
+	BigInt lhs(MakeDigits(arg));
+	BigInt rhs(MakeDigits(arg));
+	return Benchmark::MakeReport(runner.Run([&]() { return lhs + rhs; }));
+}
+
+DR_BENCHMARK(BigIntMultiply, Benchmark::Range(10, 1000, 10)) {
+	BigInt lhs(MakeDigits(arg));
+	BigInt rhs(MakeDigits(arg));
+	return Benchmark::MakeReport(runner.Run([&]() { return lhs * rhs; }));
+}
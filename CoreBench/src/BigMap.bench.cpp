@@ -0,0 +1,64 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+#include "Core/Constexpr/ConstexprCollections.h"
+
+namespace {
+	constexpr size_t Capacity = 1 << 16;
+	using Map = Constexpr::BigMap<u64, u64, Capacity>;
+
+	// Integers hash to themselves, so sequential keys would never collide.  Scrambled keys
+	// probe like real data does.
+	std::vector<u64> MakeKeys(s64 count, u64 seed) {
+		std::vector<u64> keys;
+		keys.reserve(static_cast<size_t>(count));
+		for (u64 i = 0; i < static_cast<u64>(count); i++) {
+			auto key = (i + seed) * 0x9E3779B97F4A7C15ull;
+			key ^= key >> 29;
+			keys.push_back(key);
+		}
+		return keys;
+	}
+}
+
+// Includes the clear, which is what reusing a map costs
+DR_BENCHMARK(BigMapInsert, Benchmark::Range(1024, 32768)) {
+	auto keys = MakeKeys(arg, 0);
+	Map map;
+	return Benchmark::MakeReport(runner.Run([&]() {
+		map.clear();
+		for (auto key : keys) {
+			map[key] = key;
+		}
+		return map.size();
+	}));
+}
+
+DR_BENCHMARK(BigMapFindHit, Benchmark::Range(1024, 32768)) {
+	auto keys = MakeKeys(arg, 0);
+	Map map;
+	for (auto key : keys) {
+		map[key] = key;
+	}
+	return Benchmark::MakeReport(runner.Run([&]() {
+		u64 sum = 0;
+		for (auto key : keys) {
+			sum += map.at(key);
+		}
+		return sum;
+	}));
+}
+
+DR_BENCHMARK(BigMapFindMiss, Benchmark::Range(1024, 32768)) {
+	auto keys = MakeKeys(arg, 0);
+	auto missing = MakeKeys(arg, static_cast<u64>(arg));
+	Map map;
+	for (auto key : keys) {
+		map[key] = key;
+	}
+	return Benchmark::MakeReport(runner.Run([&]() {
+		size_t found = 0;
+		for (auto key : missing) {
+			found += map.contains(key);
+		}
+		return found;
+	}));
+}
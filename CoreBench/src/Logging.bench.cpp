@@ -0,0 +1,41 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+#include "Core/Instrumentation/ISink.h"
+#include "Core/Instrumentation/Logging.h"
+
+namespace {
+	struct CountingSink : public Log::ISink {
+		CountingSink(Log::Filter filter) : ISink(filter) {}
+		~CountingSink() {
+			Unsubscribe();
+		}
+
+		void Write(const Log::Entry& entry) override {
+			Bytes += entry.Message.size();
+		}
+
+		size_t Bytes{ 0 };
+	};
+}
+
+// What a DR_LOG_DEBUG left in a hot loop costs when no sink wants debug entries
+DR_BENCHMARK(LogDisabledLevel) {
+	CountingSink sink(Log::Filter().WithLevel(Log::Level::Warning));
+	u64 value = 0;
+	return Benchmark::MakeReport(runner.Run([&]() { DR_LOG_DEBUG("Value {}", ++value); }));
+}
+
+DR_BENCHMARK(LogSync) {
+	CountingSink sink({});
+	u64 value = 0;
+	return Benchmark::MakeReport(runner.Run([&]() { DR_LOG_INFO("Value {} of {}", ++value, "LogSync"); }));
+}
+
+// The cost on the logging thread, the writer thread formats and publishes in the background
+DR_BENCHMARK(LogAsync) {
+	CountingSink sink({});
+	Log::EnableAsync({ .QueueCapacity = 8192, .BatchSize = 256, .Overflow = Log::OverflowPolicy::Block });
+	u64 value = 0;
+	auto report = Benchmark::MakeReport(runner.Run([&]() { DR_LOG_INFO("Value {} of {}", ++value, "LogAsync"); }));
+	Log::DisableAsync();
+	return report;
+}
@@ -0,0 +1,167 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace {
+	struct Options {
+		std::string JsonPath;
+		std::string CsvPath;
+		std::string BaselinePath;
+		std::string Filter;
+		bool List{ false };
+		f64 Threshold{ 0.10 };
+		u32 DurationMs{ 1000 };
+	};
+
+	void PrintUsage(const char* program) {
+		std::fprintf(stderr,
+			"Usage: %s [--filter <regex>] [--list] [--json <path>] [--csv <path>] [--baseline <csv>] [--threshold <fraction>] [--duration <ms>]\n"
+			"  --filter     only run benchmarks whose name matches, e.g. --filter \"BigMap|BigInt\"\n"
+			"  --list       print the (matching) benchmark names without running them\n"
+			"  --baseline   compare against (or create, if missing) a csv written by --csv\n"
+			"  --threshold  fail when a median runtime grows by more than this (default 0.10 = 10%%)\n"
+			"               and the samples differ significantly (95%% confidence)\n"
+			"  --duration   measuring time per benchmark (default 1000)\n", program);
+	}
+
+	// The whole text must be a number, strtod alone turns a typo into 0
+	template<typename T>
+	bool ParseNumber(const std::string& text, T& out) {
+		auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), out);
+		return error == std::errc{} && end == text.data() + text.size();
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options) {
+		for (int i = 1; i < argc; i++) {
+			std::string_view arg = argv[i];
+			if (arg == "--list") {
+				options.List = true;
+				continue;
+			}
+			if (i + 1 >= argc) return false;
+			std::string value = argv[++i];
+
+			if (arg == "--filter") options.Filter = value;
+			else if (arg == "--json") options.JsonPath = value;
+			else if (arg == "--csv") options.CsvPath = value;
+			else if (arg == "--baseline") options.BaselinePath = value;
+			else if (arg == "--threshold") {
+				if (!ParseNumber(value, options.Threshold) || !std::isfinite(options.Threshold) || options.Threshold < 0.0) return false;
+			}
+			else if (arg == "--duration") {
+				if (!ParseNumber(value, options.DurationMs) || options.DurationMs == 0) return false;
+			}
+			else return false;
+		}
+		return true;
+	}
+
+	std::string ReadFile(const std::string& path) {
+		std::ifstream stream(path, std::ios::binary);
+		std::ostringstream contents;
+		contents << stream.rdbuf();
+		return contents.str();
+	}
+
+	bool WriteFile(const std::string& path, const std::string& contents) {
+		std::ofstream stream(path, std::ios::binary);
+		stream << contents;
+		return static_cast<bool>(stream);
+	}
+}
+
+// Runs every benchmark registered in this executable, optionally failing (exit code 1) when one
+// regressed compared to a baseline
+int main(int argc, char** argv) {
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage(argv[0]);
+		return 2;
+	}
+
+	std::regex filter;
+	try {
+		filter = std::regex(options.Filter);
+	}
+	catch (const std::regex_error& error) {
+		std::fprintf(stderr, "Invalid filter '%s': %s\n", options.Filter.c_str(), error.what());
+		return 2;
+	}
+
+	const auto& registry = Benchmark::Registry::Get();
+	if (options.List) {
+		for (const auto* benchmark : registry.Find(filter)) {
+			std::printf("%s\n", benchmark->Name.c_str());
+		}
+		return 0;
+	}
+
+	auto environment = Benchmark::CaptureEnvironment();
+	std::printf("%s, %u threads, %s%s\n", environment.CpuModel.c_str(), environment.LogicalCores, environment.Compiler.c_str(),
+		environment.Governor.empty() || environment.Governor == "performance" ? "" : (", governor: " + environment.Governor).c_str());
+
+	auto runner = Benchmark::Builder()
+		.WithMaxDuration(std::chrono::milliseconds(options.DurationMs))
+		.WithRuntimeResoultion(Benchmark::RuntimeResolution::Nanos)
+		.Build();
+
+	std::vector<Benchmark::Report> reports;
+	try {
+		reports = registry.RunAll(runner, filter);
+	}
+	catch (const char* error) {
+		std::fprintf(stderr, "Benchmark failed: %s\n", error);
+		return 2;
+	}
+
+	for (const auto& report : reports) {
+		const auto& stats = report.RuntimeStats;
+		std::printf("%-40s median %10.1f%s  p99 %10.1f%s  (%llu iterations, %zu outliers)",
+			report.Name.c_str(), stats.Median, stats.Unit.c_str(), stats.Percent99, stats.Unit.c_str(),
+			static_cast<unsigned long long>(report.Iterations), report.LowOutliers + report.HighOutliers);
+		if (report.Throughput) std::printf("  %.3g calls/s", *report.Throughput);
+		if (report.Efficiency) std::printf("  %.0f%% efficiency", *report.Efficiency * 100.0);
+		std::printf("\n");
+	}
+
+	auto csv = Benchmark::ToCsv(reports);
+	if (!options.JsonPath.empty() && !WriteFile(options.JsonPath, Benchmark::ToJson(environment, reports))) {
+		std::fprintf(stderr, "Failed to write %s\n", options.JsonPath.c_str());
+		return 2;
+	}
+	if (!options.CsvPath.empty() && !WriteFile(options.CsvPath, csv)) {
+		std::fprintf(stderr, "Failed to write %s\n", options.CsvPath.c_str());
+		return 2;
+	}
+
+	if (options.BaselinePath.empty()) return 0;
+	if (!std::filesystem::exists(options.BaselinePath)) {
+		std::printf("No baseline at %s, saving this run as the baseline\n", options.BaselinePath.c_str());
+		return WriteFile(options.BaselinePath, csv) ? 0 : 2;
+	}
+
+	std::vector<Benchmark::Regression> regressions;
+	try {
+		regressions = Benchmark::FindRegressions(Benchmark::ReadCsv(ReadFile(options.BaselinePath)), reports, options.Threshold);
+	}
+	catch (const char* error) {
+		std::fprintf(stderr, "%s: %s\n", options.BaselinePath.c_str(), error);
+		return 2;
+	}
+
+	for (const auto& regression : regressions) {
+		std::printf("REGRESSION %-29s %10.1fns -> %10.1fns (+%.1f%%",
+			regression.Name.c_str(), regression.BaselineMedian, regression.CurrentMedian, regression.Change * 100.0);
+		if (regression.PValue) std::printf(", p = %.4f", *regression.PValue);
+		std::printf(")\n");
+	}
+	return regressions.empty() ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+#include "Core/Constexpr/ConstexprCollections.h"
+
+// Breadth first over a binary tree of arg nodes, the queue holds up to half of them at once
+DR_BENCHMARK(QueueBreadthFirst, Benchmark::Range(1 << 10, 1 << 20, 32)) {
+	auto nodes = static_cast<u32>(arg);
+	return Benchmark::MakeReport(runner.Run([nodes]() {
+		Constexpr::Queue<u32> queue;
+		queue.push(0);
+		u64 sum = 0;
+		while (!queue.is_empty()) {
+			auto node = queue.front();
+			queue.pop();
+			sum += node;
+			if (2 * node + 1 < nodes) queue.push(2 * node + 1);
+			if (2 * node + 2 < nodes) queue.push(2 * node + 2);
+		}
+		return sum;
+	}));
+}
@@ -0,0 +1,29 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+#include "Core/DesignPatterns/ConcurrentPubSub.h"
+#include "Core/DesignPatterns/ServiceLocator.h"
+
+#include <atomic>
+
+namespace {
+	struct Counter {
+		std::atomic<u64> Value{ 0 };
+	};
+
+	const std::vector<u32> ThreadCounts{ 1, 2, 4, 8, 16 };
+}
+
+// Publish loads the subscriber snapshot (an atomic shared_ptr) and bumps its reference count
+DR_BENCHMARK_SCALING(ConcurrentPubSubPublishThreads, ThreadCounts) {
+	ConcurrentPubSub<u64> pubSub;
+	std::atomic<u64> received{ 0 };
+	pubSub.Subscribe([&received](const u64& value) { received.fetch_add(value, std::memory_order_relaxed); });
+
+	return runner.RunScaling([&]() { pubSub.Publish(1); }, threadCounts);
+}
+
+DR_BENCHMARK_SCALING(ServiceLocatorGetThreads, ThreadCounts) {
+	auto& locator = ServiceLocator::Get();
+	locator.CreateIfMissing<Counter>();
+
+	return runner.RunScaling([&]() { return locator.Get<Counter>(); }, threadCounts);
+}
@@ -0,0 +1,18 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+#include "Core/Utilities/StringUtils.h"
+
+namespace {
+	// arg comma separated numbers
+	std::string MakeCsv(s64 fields) {
+		std::string result;
+		for (s64 i = 0; i < fields; i++) {
+			result += std::to_string(i) + ",";
+		}
+		return result;
+	}
+}
+
+DR_BENCHMARK(StringUtilsSplit, Benchmark::Range(10, 10000, 10)) {
+	auto csv = MakeCsv(arg);
+	return Benchmark::MakeReport(runner.Run([&]() { return StrUtil::Split(csv, ","); }));
+}
@@ -0,0 +1,21 @@
+#include "Core/Instrumentation/Benchmark/Registry.h"
+#include "Core/Instrumentation/Trace.h"
+
+// A begin and an end event
+DR_BENCHMARK(TraceZone) {
+	Trace::Start();
+	auto report = Benchmark::MakeReport(runner.Run([]() { DR_TRACE_ZONE("Benchmark"); }));
+	Trace::Stop();
+	return report;
+}
+
+DR_BENCHMARK(TraceZoneSteadyClock) {
+	Trace::Start({ .EventsPerThread = 1 << 16, .UseTsc = false });
+	auto report = Benchmark::MakeReport(runner.Run([]() { DR_TRACE_ZONE("Benchmark"); }));
+	Trace::Stop();
+	return report;
+}
+
+DR_BENCHMARK(TraceZoneStopped) {
+	return Benchmark::MakeReport(runner.Run([]() { DR_TRACE_ZONE("Benchmark"); }));
+}
@@ -0,0 +1,91 @@
+#include "TestCommon.h"
+
+#include "Core/DesignPatterns/ConcurrentPubSub.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct ConcurrentPubSubTest : public testing::Test {
+	ConcurrentPubSub<int> pubSub{};
+};
+
+TEST_F(ConcurrentPubSubTest, Publish_AfterSubscribe_NotifiesSubscriber) {
+	int capturedValue{ 0 };
+	pubSub.Subscribe([&](const int& event) { capturedValue = event; });
+	pubSub.Publish(42);
+
+	ASSERT_EQ(42, capturedValue);
+}
+
+TEST_F(ConcurrentPubSubTest, Publish_WithMultipleSubscribers_NotifiesAllInOrder) {
+	std::vector<int> calls;
+	pubSub.Subscribe([&](const int& event) { calls.push_back(event); });
+	pubSub.Subscribe([&](const int& event) { calls.push_back(event * 2); });
+
+	pubSub.Publish(21);
+
+	ASSERT_EQ((std::vector<int>{ 21, 42 }), calls);
+}
+
+TEST_F(ConcurrentPubSubTest, Publish_AfterSubscribeThenUnsubscribe_DoesNotNotify) {
+	auto handle = pubSub.Subscribe([&](const int&) { FAIL(); });
+	pubSub.Unsubscribe(handle);
+	pubSub.Publish(42);
+
+	ASSERT_EQ(0u, pubSub.SubscriberCount());
+}
+
+TEST_F(ConcurrentPubSubTest, Alarm_WithTwoPublishes_OnlyFiresOnce) {
+	int alarms{ 0 };
+	pubSub.Alarm([&](const int&) { alarms++; });
+
+	pubSub.Publish(1);
+	pubSub.Publish(2);
+
+	ASSERT_EQ(1, alarms);
+	ASSERT_EQ(0u, pubSub.SubscriberCount());
+}
+
+TEST_F(ConcurrentPubSubTest, Unsubscribe_FromInsideCallback_DoesNotDeadlock) {
+	size_t handle{ 0 };
+	int calls{ 0 };
+	handle = pubSub.Subscribe([&](const int&) {
+		calls++;
+		pubSub.Unsubscribe(handle);
+	});
+
+	pubSub.Publish(1);
+	pubSub.Publish(2);
+
+	ASSERT_EQ(1, calls);
+}
+
+TEST_F(ConcurrentPubSubTest, Unsubscribe_WhilePublishingFromManyThreads_NeverCallsAfterReturn) {
+	std::atomic<bool> stop{ false };
+	std::vector<std::thread> publishers;
+	for (size_t i = 0; i < 4; i++) {
+		publishers.emplace_back([&]() {
+			while (!stop.load()) {
+				pubSub.Publish(1);
+				std::this_thread::yield();
+			}
+		});
+	}
+
+	for (size_t round = 0; round < 50; round++) {
+		auto alive = std::make_unique<std::atomic<int>>(0);
+		auto* counter = alive.get();
+		auto handle = pubSub.Subscribe([counter](const int& event) { counter->fetch_add(event); });
+		std::this_thread::yield();
+		pubSub.Unsubscribe(handle);
+		// Any call after Unsubscribe returned would touch freed memory
+		alive.reset();
+	}
+
+	stop = true;
+	for (auto& publisher : publishers) {
+		publisher.join();
+	}
+	ASSERT_EQ(0u, pubSub.SubscriberCount());
+}
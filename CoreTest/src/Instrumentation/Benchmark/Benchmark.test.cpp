@@ -0,0 +1,254 @@
+#include "TestCommon.h"
+
+#include "Core/Instrumentation/Benchmark/Benchmark.h"
+
+#include <random>
+
+using namespace std::chrono_literals;
+
+namespace {
+	u64 Sum(u64 count) {
+		volatile u64 result = 0;
+		for (u64 i = 0; i < count; i++) {
+			result = result + i;
+		}
+		return result;
+	}
+
+	std::vector<f64> Noisy(f64 center, size_t count, u64 seed) {
+		std::mt19937_64 random(seed);
+		std::normal_distribution<f64> noise(0.0, center * 0.05);
+		std::vector<f64> result;
+		for (size_t i = 0; i < count; i++) {
+			result.push_back(center + noise(random));
+		}
+		return result;
+	}
+}
+
+TEST(Benchmark, Run_WithFastFunction_CalibratesBatchSize) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(1ms)
+		.WithMaxDuration(20ms)
+		.WithRuntimeResoultion(Benchmark::RuntimeResolution::Nanos)
+		.Build();
+
+	auto result = runner.Run(Sum, 10);
+
+	ASSERT_GT(result.BatchSize, 1u);
+	ASSERT_EQ("ns", result.RuntimeStats.Unit);
+	ASSERT_GT(result.RuntimeStats.Median, 0.0);
+	ASSERT_LT(result.RuntimeStats.Median, 10'000.0);
+	ASSERT_EQ(Sum(10), result.ReturnValue);
+}
+
+TEST(Benchmark, Run_WithMaxIterations_StopsAtIterationCount) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(0ms)
+		.WithMaxIterations(1000)
+		.Build();
+
+	auto result = runner.Run(Sum, 10);
+
+	ASSERT_EQ(1000u, result.Iterations);
+	ASSERT_EQ(result.Samples.size(), result.RuntimeStats.Count);
+}
+
+TEST(Benchmark, Run_WithMaxSamples_BoundsSamples) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(0ms)
+		.WithMinBatchDuration(0ns)
+		.WithMaxIterations(5000)
+		.WithMaxSamples(100)
+		.Build();
+
+	auto result = runner.Run(Sum, 10);
+
+	ASSERT_EQ(1u, result.BatchSize);
+	ASSERT_EQ(100u, result.Samples.size());
+	ASSERT_EQ(5000u, result.RuntimeStats.Count);
+}
+
+TEST(Benchmark, CountOutliers_WithExtremeValues_CountsBothSides) {
+	std::vector<f64> values(100, 10.0);
+	for (size_t i = 0; i < values.size(); i++) {
+		values[i] += static_cast<f64>(i % 10) * 0.1;
+	}
+	values.push_back(1000.0);
+	values.push_back(1001.0);
+	values.push_back(-1000.0);
+
+	auto [low, high] = Benchmark::Detail::CountOutliers(values);
+
+	ASSERT_EQ(1u, low);
+	ASSERT_EQ(2u, high);
+}
+
+TEST(Benchmark, Compare_WithFasterCandidate_ReportsSignificantSpeedup) {
+	auto baseline = Noisy(100.0, 500, 1);
+	auto candidate = Noisy(50.0, 500, 2);
+
+	auto comparison = Benchmark::Compare(baseline, candidate);
+
+	ASSERT_NEAR(2.0, comparison.Speedup, 0.05);
+	ASSERT_LE(comparison.SpeedupLow, comparison.Speedup);
+	ASSERT_GE(comparison.SpeedupHigh, comparison.Speedup);
+	ASSERT_LT(comparison.SpeedupHigh - comparison.SpeedupLow, 0.2);
+	ASSERT_TRUE(comparison.IsSignificant());
+	ASSERT_TRUE(Benchmark::ToString(comparison).starts_with("2."));
+}
+
+TEST(Benchmark, Compare_WithSameDistribution_IsNotSignificant) {
+	auto baseline = Noisy(100.0, 500, 1);
+	auto candidate = Noisy(100.0, 500, 2);
+
+	auto comparison = Benchmark::Compare(baseline, candidate);
+
+	ASSERT_FALSE(comparison.IsSignificant());
+	ASSERT_LE(comparison.SpeedupLow, 1.0);
+	ASSERT_GE(comparison.SpeedupHigh, 1.0);
+}
+
+TEST(Benchmark, Compare_WithRunner_PrefersLessWork) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(1ms)
+		.WithMaxDuration(50ms)
+		.WithRuntimeResoultion(Benchmark::RuntimeResolution::Nanos)
+		.Build();
+
+	auto comparison = runner.Compare([]() { return Sum(2000); }, []() { return Sum(200); });
+
+	ASSERT_GT(comparison.Speedup, 2.0);
+	ASSERT_TRUE(comparison.IsSignificant());
+}
+
+TEST(Benchmark, Run_WithVoidFunction_Runs) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(0ms)
+		.WithMaxIterations(100)
+		.Build();
+	u32 calls = 0;
+
+	auto result = runner.Run([&calls]() { calls++; });
+
+	ASSERT_EQ(100u, result.Iterations);
+	ASSERT_GE(calls, 100u);
+}
+
+TEST(Benchmark, Run_WithNonDefaultConstructibleResult_KeepsLastValue) {
+	struct Value {
+		explicit Value(u32 value) : Data(value) {}
+		u32 Data;
+	};
+	auto runner = Benchmark::Builder()
+		.WithWarmup(0ms)
+		.WithMaxIterations(10)
+		.Build();
+	u32 calls = 0;
+
+	auto result = runner.Run([&calls]() { return Value(++calls); });
+
+	ASSERT_EQ(calls, result.ReturnValue.Data);
+}
+
+TEST(Benchmark, RunRotating_WithPool_UsesEverySet) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(0ms)
+		.WithMinBatchDuration(0ns)
+		.WithMaxIterations(100)
+		.Build();
+	auto pool = Benchmark::ArgumentPool<u32, u32>::Generate(10, [](size_t i) {
+		return std::make_tuple(static_cast<u32>(i), 1u);
+	});
+	std::vector<u32> seen(pool.Size(), 0);
+
+	auto result = runner.RunRotating([&seen](u32 index, u32 add) {
+		seen[index] += add;
+		return index;
+	}, pool);
+
+	ASSERT_EQ(100u, result.Iterations);
+	for (auto count : seen) {
+		ASSERT_GE(count, 10u);
+	}
+}
+
+TEST(Benchmark, ArgumentPool_ExceedingCache_CoversTwiceTheCache) {
+	constexpr size_t BytesPerSet = 1024 * 1024;
+	auto pool = Benchmark::ArgumentPool<size_t>::ExceedingCache(BytesPerSet, [](size_t i) { return std::make_tuple(i); });
+
+	ASSERT_GE(pool.Size() * BytesPerSet, 2 * Benchmark::LastLevelCacheSize());
+	ASSERT_EQ(0u, std::get<0>(pool.Next()));
+	ASSERT_EQ(1u, std::get<0>(pool.Next()));
+}
+
+TEST(Benchmark, DoNotOptimize_KeepsLoopAlive) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(0ms)
+		.WithMinBatchDuration(0ns)
+		.WithMaxIterations(1000)
+		.WithRuntimeResoultion(Benchmark::RuntimeResolution::Nanos)
+		.Build();
+
+	auto result = runner.Run([]() {
+		u64 sum = 0;
+		for (u64 i = 0; i < 10'000; i++) {
+			sum += i;
+			Benchmark::DoNotOptimize(sum);
+		}
+		Benchmark::ClobberMemory();
+	});
+
+	// 10k dependent adds can't take less than a few hundred nanoseconds
+	ASSERT_GT(result.RuntimeStats.Median, 500.0);
+}
+
+TEST(Benchmark, RunScaling_RunsEachThreadCount) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(0ms)
+		.WithMinBatchDuration(0ns)
+		.WithMaxIterations(200)
+		.WithRuntimeResoultion(Benchmark::RuntimeResolution::Nanos)
+		.Build();
+	std::atomic<u64> calls{ 0 };
+
+	auto points = runner.RunScaling([&calls]() { return calls.fetch_add(1, std::memory_order_relaxed); }, { 1, 2, 4 });
+
+	ASSERT_EQ(3u, points.size());
+	ASSERT_EQ(1.0, points[0].Efficiency);
+	for (u32 i = 0; i < points.size(); i++) {
+		const auto& point = points[i];
+		ASSERT_EQ(1u << i, point.Threads);
+		ASSERT_EQ(point.Threads, point.ThreadLatency.size());
+		// Each thread stops at MaxIterations
+		ASSERT_EQ(200u * point.Threads, point.Iterations);
+		ASSERT_EQ(point.Iterations, point.Latency.Count);
+		ASSERT_GT(point.Throughput, 0.0);
+		ASSERT_EQ("ns", point.Latency.Unit);
+	}
+	// Plus the warmup calls
+	ASSERT_GE(calls.load(), 200u * 7u);
+}
+
+TEST(Benchmark, RunScaling_PassesThreadIndex) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(0ms)
+		.WithMinBatchDuration(0ns)
+		.WithMaxIterations(50)
+		.WithThreadPinning()
+		.Build();
+	std::array<std::atomic<u64>, 3> callsPerThread{};
+
+	auto points = runner.RunScaling([&callsPerThread](u32 index) { callsPerThread[index]++; }, { 3 });
+
+	ASSERT_EQ(1u, points.size());
+	for (const auto& calls : callsPerThread) {
+		ASSERT_GE(calls.load(), 50u);
+	}
+}
+
+TEST(Benchmark, RunScaling_WithZeroThreads_Throws) {
+	auto runner = Benchmark::Builder().WithWarmup(0ms).Build();
+
+	ASSERT_ANY_THROW(runner.RunScaling([]() {}, { 0 }));
+}
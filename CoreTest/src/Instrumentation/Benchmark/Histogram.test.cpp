@@ -0,0 +1,110 @@
+#include "TestCommon.h"
+
+#include "Core/Instrumentation/Benchmark/Histogram.h"
+#include "Core/Instrumentation/Benchmark/Stats.h"
+
+#include <random>
+
+TEST(Histogram, Empty_ReportsZero) {
+	Histogram histogram;
+
+	ASSERT_EQ(0u, histogram.Count());
+	ASSERT_EQ(0.0, histogram.Min());
+	ASSERT_EQ(0.0, histogram.Max());
+	ASSERT_EQ(0.0, histogram.Percentile(50.0));
+}
+
+TEST(Histogram, Add_TracksExactMinMaxAndMean) {
+	Histogram histogram;
+	for (auto value : { 3.0, 1.0, 2.0, 0.0, -4.0 }) {
+		histogram.Add(value);
+	}
+
+	ASSERT_EQ(5u, histogram.Count());
+	ASSERT_EQ(-4.0, histogram.Min());
+	ASSERT_EQ(3.0, histogram.Max());
+	ASSERT_DOUBLE_EQ(0.4, histogram.Mean());
+	ASSERT_EQ(-4.0, histogram.Percentile(0.0));
+	ASSERT_EQ(3.0, histogram.Percentile(100.0));
+}
+
+TEST(Histogram, Add_WithNaN_IsIgnored) {
+	Histogram histogram;
+	histogram.Add(std::numeric_limits<f64>::quiet_NaN());
+
+	ASSERT_EQ(0u, histogram.Count());
+}
+
+TEST(Histogram, Percentile_WithUniformValues_IsWithinBucketPrecision) {
+	Histogram histogram;
+	for (u32 i = 1; i <= 100'000; i++) {
+		histogram.Add(static_cast<f64>(i));
+	}
+
+	const f64 tolerance = 1.0 / (1 << Histogram::DefaultPrecisionBits);
+	for (auto percent : { 50.0, 90.0, 99.0, 99.9, 99.99 }) {
+		auto expected = percent * 1000.0;
+		ASSERT_NEAR(expected, histogram.Percentile(percent), expected * tolerance) << percent;
+	}
+}
+
+TEST(Histogram, Add_OutsideRange_ClampsIntoEndBuckets) {
+	Histogram histogram(4, 1.0, 1024.0);
+	auto buckets = histogram.BucketCount();
+	histogram.Add(0.001);
+	histogram.Add(1'000'000.0);
+
+	ASSERT_EQ(buckets, histogram.BucketCount());
+	ASSERT_EQ(0.001, histogram.Percentile(10.0));
+	ASSERT_EQ(1'000'000.0, histogram.Percentile(100.0));
+}
+
+TEST(Histogram, Merge_MatchesSingleHistogram) {
+	std::mt19937 random(42);
+	std::lognormal_distribution<f64> distribution(3.0, 1.0);
+
+	Histogram all, first, second;
+	for (size_t i = 0; i < 10'000; i++) {
+		auto value = distribution(random);
+		all.Add(value);
+		(i % 3 == 0 ? first : second).Add(value);
+	}
+	first.Merge(second);
+
+	ASSERT_EQ(all.Count(), first.Count());
+	ASSERT_EQ(all.Min(), first.Min());
+	ASSERT_EQ(all.Max(), first.Max());
+	ASSERT_NEAR(all.Mean(), first.Mean(), 1e-9);
+	ASSERT_NEAR(all.StdDev(), first.StdDev(), 1e-6);
+	for (auto percent : { 50.0, 99.0, 99.9 }) {
+		ASSERT_EQ(all.Percentile(percent), first.Percentile(percent));
+	}
+}
+
+TEST(Histogram, Merge_WithDifferentLayout_Throws) {
+	Histogram first(7);
+	Histogram second(5);
+
+	ASSERT_ANY_THROW(first.Merge(second));
+}
+
+TEST(Histogram, Stats_FromHistogram_MatchesStatsFromValues) {
+	std::vector<f64> values;
+	Histogram histogram;
+	for (u32 i = 1; i <= 1000; i++) {
+		values.push_back(static_cast<f64>(i));
+		histogram.Add(static_cast<f64>(i));
+	}
+
+	auto exact = Stats(values, "us");
+	auto approx = Stats(histogram, "us");
+
+	ASSERT_EQ(exact.Count, approx.Count);
+	ASSERT_EQ(exact.Min, approx.Min);
+	ASSERT_EQ(exact.Max, approx.Max);
+	ASSERT_DOUBLE_EQ(exact.Mean, approx.Mean);
+	ASSERT_NEAR(exact.StdDev, approx.StdDev, 1e-6);
+	ASSERT_NEAR(exact.Median, approx.Median, exact.Median / 64.0);
+	ASSERT_NEAR(exact.Percent99, approx.Percent99, exact.Percent99 / 64.0);
+	ASSERT_EQ("us", approx.Unit);
+}
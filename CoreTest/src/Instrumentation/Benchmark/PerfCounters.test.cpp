@@ -0,0 +1,60 @@
+#include "TestCommon.h"
+
+#include "Core/Instrumentation/Benchmark/Benchmark.h"
+#include "Core/Instrumentation/Benchmark/PerfCounters.h"
+
+namespace {
+	u64 Spin(u64 count) {
+		volatile u64 result = 0;
+		for (u64 i = 0; i < count; i++) {
+			result = result + i;
+		}
+		return result;
+	}
+}
+
+TEST(PerfCounters, GetAvailable_WithRequestedCounters_IsSubsetInRequestOrder) {
+	PerfCounters counters({ PerfCounter::Instructions, PerfCounter::Cycles, PerfCounter::Instructions });
+
+	const auto& available = counters.GetAvailable();
+	ASSERT_LE(available.size(), 2u);
+	if (available.size() == 2) {
+		ASSERT_EQ(PerfCounter::Instructions, available[0]);
+		ASSERT_EQ(PerfCounter::Cycles, available[1]);
+	}
+}
+
+TEST(PerfCounters, Read_AfterWork_CountsInstructions) {
+	PerfCounters counters({ PerfCounter::Instructions });
+	if (!counters.IsAvailable(PerfCounter::Instructions)) GTEST_SKIP() << "perf events unavailable";
+
+	u64 before = 0;
+	u64 after = 0;
+	counters.Start();
+	counters.Read({ &before, 1 });
+	Spin(100'000);
+	counters.Read({ &after, 1 });
+	counters.Stop();
+
+	ASSERT_GT(after - before, 100'000u);
+}
+
+TEST(PerfCounters, Run_WithPerfCounters_ReportsOnlyAvailableCounters) {
+	auto runner = Benchmark::Builder()
+		.WithWarmup(std::chrono::milliseconds(0))
+		.WithMinBatchDuration(std::chrono::nanoseconds(0))
+		.WithMaxIterations(10)
+		.WithPerfCounters({ PerfCounter::Cycles, PerfCounter::Instructions, PerfCounter::BranchMisses })
+		.Build();
+	PerfCounters probe({ PerfCounter::Cycles, PerfCounter::Instructions, PerfCounter::BranchMisses });
+
+	auto result = runner.Run(Spin, 10'000);
+
+	ASSERT_EQ(10u, result.RuntimeStats.Count);
+	ASSERT_EQ(probe.GetAvailable().size(), result.CounterStats.size());
+	for (const auto& [counter, stats] : result.CounterStats) {
+		ASSERT_TRUE(probe.IsAvailable(counter));
+		ASSERT_EQ(10u, stats.Count);
+	}
+	ASSERT_EQ(probe.IsAvailable(PerfCounter::Cycles) && probe.IsAvailable(PerfCounter::Instructions), result.Ipc.has_value());
+}
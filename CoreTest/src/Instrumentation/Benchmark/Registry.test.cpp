@@ -0,0 +1,126 @@
+#include "TestCommon.h"
+
+#include "Core/Instrumentation/Benchmark/Registry.h"
+
+namespace {
+	Benchmark::Runner MakeQuickRunner() {
+		return Benchmark::Builder()
+			.WithMaxIterations(10)
+			.WithWarmup(std::chrono::milliseconds(0))
+			.WithMinBatchDuration(std::chrono::milliseconds(0))
+			.Build();
+	}
+
+	Benchmark::Report EmptyReport(const Benchmark::Runner&) {
+		return {};
+	}
+
+	s64 LastArg = -1;
+}
+
+DR_BENCHMARK(RegistryTestMacro) {
+	return Benchmark::MakeReport(runner.Run([]() { return 1 + 1; }));
+}
+
+DR_BENCHMARK(RegistryTestMacroWithArgs, std::vector<s64>{ 3, 5 }) {
+	LastArg = arg;
+	return {};
+}
+
+TEST(Registry, Range_MultipliesUpToHigh) {
+	ASSERT_EQ(std::vector<s64>({ 8, 64, 512, 1000 }), Benchmark::Range(8, 1000));
+	ASSERT_EQ(std::vector<s64>({ 1, 2, 4, 8 }), Benchmark::Range(1, 8, 2));
+	ASSERT_EQ(std::vector<s64>({ 4 }), Benchmark::Range(4, 4));
+	ASSERT_ANY_THROW(Benchmark::Range(8, 1));
+}
+
+TEST(Registry, DenseRange_StepsUpToHigh) {
+	ASSERT_EQ(std::vector<s64>({ 1, 2, 3, 4 }), Benchmark::DenseRange(1, 4));
+	ASSERT_EQ(std::vector<s64>({ 1, 4, 7 }), Benchmark::DenseRange(1, 8, 3));
+}
+
+TEST(Registry, RunAll_NamesReportsAfterBenchmarks) {
+	Benchmark::Registry registry;
+	registry.Add("First", [](const Benchmark::Runner& runner) {
+		return Benchmark::MakeReport(runner.Run([]() { return 1 + 1; }));
+	});
+	registry.Add("Second", [](const Benchmark::Runner&) {
+		Benchmark::Report report;
+		report.Name = "Ignored";
+		return report;
+	});
+
+	auto reports = registry.RunAll(MakeQuickRunner());
+
+	ASSERT_EQ(2u, reports.size());
+	ASSERT_EQ("First", reports[0].Name);
+	ASSERT_EQ("Second", reports[1].Name);
+	ASSERT_GT(reports[0].Iterations, 0u);
+}
+
+TEST(Registry, Add_WithArgs_RegistersOnePerArg) {
+	Benchmark::Registry registry;
+	registry.Add("Sized", [](const Benchmark::Runner&, s64 arg) {
+		Benchmark::Report report;
+		report.Iterations = static_cast<u64>(arg);
+		return report;
+	}, { 8, 64 });
+
+	auto reports = registry.RunAll(MakeQuickRunner());
+
+	ASSERT_EQ(2u, reports.size());
+	ASSERT_EQ("Sized/8", reports[0].Name);
+	ASSERT_EQ(8u, reports[0].Iterations);
+	ASSERT_EQ("Sized/64", reports[1].Name);
+	ASSERT_EQ(64u, reports[1].Iterations);
+}
+
+TEST(Registry, AddScaling_ReportsEveryPointOfOneRun) {
+	Benchmark::Registry registry;
+	size_t runs = 0;
+	registry.AddScaling("Threads", [&runs](const Benchmark::Runner&, const std::vector<u32>& threadCounts) {
+		runs++;
+		std::vector<Benchmark::ScalingPoint> points;
+		for (auto threads : threadCounts) {
+			auto& point = points.emplace_back();
+			point.Threads = threads;
+			point.Throughput = 100.0 * threads;
+			point.Efficiency = 1.0 / threads;
+		}
+		return points;
+	}, { 1, 4 });
+
+	auto reports = registry.RunAll(MakeQuickRunner());
+
+	ASSERT_EQ(1u, runs);
+	ASSERT_EQ(2u, reports.size());
+	ASSERT_EQ("Threads/1", reports[0].Name);
+	ASSERT_EQ("Threads/4", reports[1].Name);
+	ASSERT_EQ(400.0, reports[1].Throughput);
+	ASSERT_EQ(0.25, reports[1].Efficiency);
+	ASSERT_NE(std::string::npos, Benchmark::ToJson({}, reports).find("\"efficiency\": 0.25"));
+}
+
+TEST(Registry, RunAll_WithFilter_OnlyRunsMatches) {
+	Benchmark::Registry registry;
+	registry.Add("BigMapInsert", EmptyReport);
+	registry.Add("BigMapFind", EmptyReport);
+	registry.Add("BigIntAdd", EmptyReport);
+
+	auto reports = registry.RunAll(MakeQuickRunner(), std::regex("Map.*Find|Int"));
+
+	ASSERT_EQ(2u, reports.size());
+	ASSERT_EQ("BigMapFind", reports[0].Name);
+	ASSERT_EQ("BigIntAdd", reports[1].Name);
+}
+
+TEST(Registry, Macro_RegistersWithTheGlobalRegistry) {
+	auto found = Benchmark::Registry::Get().Find(std::regex("^RegistryTestMacro"));
+	ASSERT_EQ(3u, found.size());
+	ASSERT_EQ("RegistryTestMacro", found[0]->Name);
+	ASSERT_EQ("RegistryTestMacroWithArgs/3", found[1]->Name);
+	ASSERT_EQ("RegistryTestMacroWithArgs/5", found[2]->Name);
+
+	found[2]->Func(MakeQuickRunner());
+	ASSERT_EQ(5, LastArg);
+}
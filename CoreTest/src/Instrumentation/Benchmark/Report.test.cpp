@@ -0,0 +1,135 @@
+#include "TestCommon.h"
+
+#include "Core/Instrumentation/Benchmark/Report.h"
+
+namespace {
+	Benchmark::Report MakeTestReport(std::string name, f64 median, std::string unit = "ns") {
+		Benchmark::Report report;
+		report.Name = std::move(name);
+		report.RuntimeStats = Stats({ median - 1.0, median, median + 1.0 }, std::move(unit));
+		report.Iterations = 300;
+		report.BatchSize = 100;
+		return report;
+	}
+
+	// 100 samples spread evenly over [median - 25, median + 25)
+	std::vector<f64> SpreadSamples(f64 median) {
+		std::vector<f64> samples;
+		for (int i = 0; i < 100; i++) {
+			samples.push_back(median - 25.0 + (i * 37 % 100) * 0.5);
+		}
+		return samples;
+	}
+}
+
+TEST(Report, ToJson_ContainsEnvironmentAndBenchmarks) {
+	auto environment = Benchmark::CaptureEnvironment();
+	auto json = Benchmark::ToJson(environment, { MakeTestReport("Split", 10.0) });
+
+	ASSERT_NE(std::string::npos, json.find("\"environment\""));
+	ASSERT_NE(std::string::npos, json.find("\"compiler\""));
+	ASSERT_NE(std::string::npos, json.find("\"name\": \"Split\""));
+	ASSERT_NE(std::string::npos, json.find("\"median\": 10"));
+	ASSERT_NE(std::string::npos, json.find("\"ipc\": null"));
+}
+
+TEST(Report, ToJson_EscapesStrings) {
+	auto json = Benchmark::ToJson({}, { MakeTestReport("Quote\"Back\\slash\n", 1.0) });
+
+	ASSERT_NE(std::string::npos, json.find(R"("Quote\"Back\\slash\n")"));
+}
+
+TEST(Report, Csv_RoundTrips) {
+	std::vector<Benchmark::Report> reports{ MakeTestReport("Plain", 10.0), MakeTestReport("With,Comma \"and quotes\"", 2.5, "us") };
+	reports[1].LowOutliers = 2;
+	reports[1].HighOutliers = 3;
+
+	auto restored = Benchmark::ReadCsv(Benchmark::ToCsv(reports));
+
+	ASSERT_EQ(2u, restored.size());
+	for (size_t i = 0; i < reports.size(); i++) {
+		ASSERT_EQ(reports[i].Name, restored[i].Name);
+		ASSERT_EQ(reports[i].RuntimeStats.Unit, restored[i].RuntimeStats.Unit);
+		ASSERT_EQ(reports[i].RuntimeStats.Count, restored[i].RuntimeStats.Count);
+		ASSERT_EQ(reports[i].RuntimeStats.Median, restored[i].RuntimeStats.Median);
+		ASSERT_EQ(reports[i].RuntimeStats.StdDev, restored[i].RuntimeStats.StdDev);
+		ASSERT_EQ(reports[i].Iterations, restored[i].Iterations);
+		ASSERT_EQ(reports[i].BatchSize, restored[i].BatchSize);
+		ASSERT_EQ(reports[i].LowOutliers, restored[i].LowOutliers);
+		ASSERT_EQ(reports[i].HighOutliers, restored[i].HighOutliers);
+	}
+}
+
+TEST(Report, Csv_KeepsAtMostMaxCsvSamples) {
+	std::vector<Benchmark::Report> reports{ MakeTestReport("Few", 10.0), MakeTestReport("Many", 10.0) };
+	reports[0].Samples = { 9.5, 10.25, 11.0 };
+	for (size_t i = 0; i < 10'000; i++) {
+		reports[1].Samples.push_back(static_cast<f64>(i));
+	}
+
+	auto restored = Benchmark::ReadCsv(Benchmark::ToCsv(reports));
+
+	ASSERT_EQ(reports[0].Samples, restored[0].Samples);
+	ASSERT_EQ(Benchmark::MaxCsvSamples, restored[1].Samples.size());
+	ASSERT_TRUE(std::is_sorted(restored[1].Samples.begin(), restored[1].Samples.end()));
+	ASSERT_LT(restored[1].Samples.front(), 100.0);
+	ASSERT_GT(restored[1].Samples.back(), 9'900.0);
+}
+
+TEST(Report, ReadCsv_WithoutSamplesColumn_ReadsReports) {
+	auto reports = Benchmark::ReadCsv(
+		"name,unit,count,mean,median,min,max,stddev,p75,p90,p99,iterations,batch_size,low_outliers,high_outliers\n"
+		"Split,ns,3,10,10,9,11,1,10,11,11,300,100,0,0\n");
+
+	ASSERT_EQ(1u, reports.size());
+	ASSERT_EQ(10.0, reports[0].RuntimeStats.Median);
+	ASSERT_TRUE(reports[0].Samples.empty());
+}
+
+TEST(Report, ReadCsv_ThrowsOnMalformedInput) {
+	ASSERT_ANY_THROW(Benchmark::ReadCsv("not,a,benchmark,csv\n"));
+
+	auto csv = Benchmark::ToCsv({ MakeTestReport("Split", 10.0) });
+	ASSERT_ANY_THROW(Benchmark::ReadCsv(csv + "Truncated,ns,3\n"));
+}
+
+TEST(Report, FindRegressions_OnlyReportsChangesAboveThreshold) {
+	std::vector<Benchmark::Report> baseline{ MakeTestReport("Same", 100.0), MakeTestReport("Slower", 100.0), MakeTestReport("Faster", 100.0), MakeTestReport("Removed", 100.0) };
+	std::vector<Benchmark::Report> current{ MakeTestReport("Same", 105.0), MakeTestReport("Slower", 150.0), MakeTestReport("Faster", 50.0), MakeTestReport("Added", 100.0) };
+
+	auto regressions = Benchmark::FindRegressions(baseline, current, 0.1);
+
+	ASSERT_EQ(1u, regressions.size());
+	ASSERT_EQ("Slower", regressions[0].Name);
+	ASSERT_DOUBLE_EQ(0.5, regressions[0].Change);
+}
+
+TEST(Report, FindRegressions_ConvertsUnits) {
+	std::vector<Benchmark::Report> baseline{ MakeTestReport("Split", 2.0, "us") };
+	std::vector<Benchmark::Report> same{ MakeTestReport("Split", 2000.0, "ns") };
+	std::vector<Benchmark::Report> slower{ MakeTestReport("Split", 3000.0, "ns") };
+
+	ASSERT_TRUE(Benchmark::FindRegressions(baseline, same, 0.1).empty());
+
+	auto regressions = Benchmark::FindRegressions(baseline, slower, 0.1);
+	ASSERT_EQ(1u, regressions.size());
+	ASSERT_DOUBLE_EQ(2000.0, regressions[0].BaselineMedian);
+	ASSERT_DOUBLE_EQ(3000.0, regressions[0].CurrentMedian);
+}
+
+TEST(Report, FindRegressions_WithSamples_RequiresSignificance) {
+	std::vector<Benchmark::Report> baseline{ MakeTestReport("Noisy", 100.0), MakeTestReport("Slower", 100.0) };
+	std::vector<Benchmark::Report> current{ MakeTestReport("Noisy", 150.0), MakeTestReport("Slower", 150.0) };
+	baseline[0].Samples = SpreadSamples(100.0);
+	baseline[1].Samples = SpreadSamples(100.0);
+	// The median moved but the samples are the same, e.g. one unlucky run
+	current[0].Samples = SpreadSamples(100.0);
+	current[1].Samples = SpreadSamples(150.0);
+
+	auto regressions = Benchmark::FindRegressions(baseline, current, 0.1);
+
+	ASSERT_EQ(1u, regressions.size());
+	ASSERT_EQ("Slower", regressions[0].Name);
+	ASSERT_TRUE(regressions[0].PValue.has_value());
+	ASSERT_LT(*regressions[0].PValue, 0.05);
+}
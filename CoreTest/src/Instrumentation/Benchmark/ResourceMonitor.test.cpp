@@ -13,8 +13,55 @@ TEST(ResourceMonitor, Stats_AfterRunning_ArePopulated)
 		std::this_thread::sleep_for(1s);
 	}
 
-	auto result = stats.GetStats();
+	auto result = stats.GetStats("");
 	ASSERT_TRUE(result.Mean > 0.0);
 	ASSERT_EQ(result.Min, 0.0);
 	ASSERT_TRUE(result.Max > 0.0);
-}
\ No newline at end of file
+}
+
+TEST(ResourceMonitor, PMem_AfterRunning_ReportsResidentBytes)
+{
+	auto stats = StatHolder();
+	{
+		auto monitor = ResourceMonitor(MonitorType::PMem, 10ms, stats);
+		monitor.Start();
+		std::this_thread::sleep_for(100ms);
+	}
+
+	auto result = stats.GetStats("");
+	ASSERT_TRUE(result.Min > 0.0);
+}
+
+TEST(ResourceMonitor, VMem_AfterRunning_ReportsAtLeastResidentBytes)
+{
+	auto pmem = StatHolder();
+	auto vmem = StatHolder();
+	{
+		auto pmemMonitor = ResourceMonitor(MonitorType::PMem, 10ms, pmem);
+		auto vmemMonitor = ResourceMonitor(MonitorType::VMem, 10ms, vmem);
+		pmemMonitor.Start();
+		vmemMonitor.Start();
+		std::this_thread::sleep_for(100ms);
+	}
+
+	ASSERT_TRUE(vmem.GetStats("").Min > 0.0);
+	ASSERT_TRUE(vmem.GetStats("").Max >= pmem.GetStats("").Min);
+}
+
+TEST(ResourceMonitor, Cpu_WhileBusy_ReportsFractionOfMachine)
+{
+	auto stats = StatHolder();
+	{
+		auto monitor = ResourceMonitor(MonitorType::Cpu, 10ms, stats);
+		monitor.Start();
+		auto end = std::chrono::steady_clock::now() + 200ms;
+		volatile u64 spin = 0;
+		while (std::chrono::steady_clock::now() < end) {
+			spin = spin + 1;
+		}
+	}
+
+	auto result = stats.GetStats("");
+	ASSERT_TRUE(result.Max > 0.0);
+	ASSERT_TRUE(result.Median <= 1.5);
+}
@@ -0,0 +1,124 @@
+#include "TestCommon.h"
+
+#include "Core/Instrumentation/LogWriter/BinaryLogReader.h"
+#include "Core/Instrumentation/LogWriter/BinaryLogWriter.h"
+
+#include <filesystem>
+#include <fstream>
+
+struct BinaryLogTest : public testing::Test {
+	void SetUp() override {
+		auto name = std::string("BinaryLogTest_") + testing::UnitTest::GetInstance()->current_test_info()->name();
+		Directory = (std::filesystem::temp_directory_path() / name).string();
+		std::filesystem::remove_all(Directory);
+	}
+
+	void TearDown() override {
+		std::filesystem::remove_all(Directory);
+	}
+
+	BinaryLogWriter::Options MakeOptions(size_t segmentSize = 1024 * 1024, size_t maxSegments = 0) {
+		return { .Directory = Directory, .BaseName = "test", .SegmentSize = segmentSize, .MaxSegments = maxSegments };
+	}
+
+	std::vector<BinaryLogReader::Record> ReadAll() {
+		std::vector<BinaryLogReader::Record> result;
+		for (const auto& segment : BinaryLogReader::FindSegments(Directory, "test")) {
+			auto records = BinaryLogReader::ReadSegment(segment);
+			result.insert(result.end(), records.begin(), records.end());
+		}
+		return result;
+	}
+
+	std::string Directory;
+};
+
+TEST_F(BinaryLogTest, ReadSegment_AfterWrite_RoundTripsEntry) {
+	Log::Entry entry(Log::Level::Warning, "Hello binary", Debug::Context());
+	{
+		BinaryLogWriter writer({}, MakeOptions());
+		writer.Write(entry);
+	}
+
+	auto records = ReadAll();
+	ASSERT_EQ(1u, records.size());
+	ASSERT_EQ(Log::Level::Warning, records[0].LogLevel);
+	ASSERT_EQ("Hello binary", records[0].Message);
+	ASSERT_EQ(std::string(entry.Context.FileName()), records[0].FileName);
+	ASSERT_EQ(std::string(entry.Context.Function()), records[0].Function);
+	ASSERT_EQ(entry.Context.LineNumber, records[0].LineNumber);
+	ASSERT_EQ(std::chrono::time_point_cast<std::chrono::nanoseconds>(entry.Time), std::chrono::time_point_cast<std::chrono::nanoseconds>(records[0].Time));
+}
+
+TEST_F(BinaryLogTest, Write_ThroughLogging_WritesMatchingEntries) {
+	{
+		BinaryLogWriter writer(Log::Filter().WithLevel(Log::Level::Info), MakeOptions());
+		Log::Debug("Filtered");
+		Log::Info("First");
+		DR_LOG_WARN("Second {}", 2);
+		Log::Flush();
+	}
+
+	auto records = ReadAll();
+	ASSERT_EQ(2u, records.size());
+	ASSERT_EQ("First", records[0].Message);
+	ASSERT_EQ("Second 2", records[1].Message);
+}
+
+TEST_F(BinaryLogTest, Write_PastSegmentSize_RotatesAndKeepsEveryEntry) {
+	{
+		BinaryLogWriter writer({}, MakeOptions(4096));
+		for (size_t i = 0; i < 500; i++) {
+			writer.Write(Log::Entry(Log::Level::Info, std::to_string(i), Debug::Context()));
+		}
+		ASSERT_GT(writer.GetSegments().size(), 1u);
+	}
+
+	auto records = ReadAll();
+	ASSERT_EQ(500u, records.size());
+	for (size_t i = 0; i < records.size(); i++) {
+		ASSERT_EQ(std::to_string(i), records[i].Message);
+	}
+}
+
+TEST_F(BinaryLogTest, Write_WithMaxSegments_DeletesOldestSegments) {
+	{
+		BinaryLogWriter writer({}, MakeOptions(4096, 2));
+		for (size_t i = 0; i < 500; i++) {
+			writer.Write(Log::Entry(Log::Level::Info, std::to_string(i), Debug::Context()));
+		}
+	}
+
+	ASSERT_EQ(2u, BinaryLogReader::FindSegments(Directory, "test").size());
+	auto records = ReadAll();
+	ASSERT_FALSE(records.empty());
+	ASSERT_EQ("499", records.back().Message);
+}
+
+TEST_F(BinaryLogTest, Write_WithMessageLargerThanSegment_Truncates) {
+	{
+		BinaryLogWriter writer({}, MakeOptions(4096));
+		writer.Write(Log::Entry(Log::Level::Info, std::string(10000, 'x'), Debug::Context()));
+	}
+
+	ASSERT_EQ(1u, BinaryLogReader::FindSegments(Directory, "test").size());
+	auto records = ReadAll();
+	ASSERT_EQ(1u, records.size());
+	ASSERT_LT(records[0].Message.size(), 4096u);
+}
+
+TEST_F(BinaryLogTest, ReadSegment_WithTextFile_Throws) {
+	std::filesystem::create_directories(Directory);
+	auto path = (std::filesystem::path(Directory) / "test.000000.drlog").string();
+	std::ofstream(path) << "not a log";
+
+	ASSERT_ANY_THROW(BinaryLogReader::ReadSegment(path));
+}
+
+TEST_F(BinaryLogTest, ToString_WithRecord_IncludesLevelLocationAndMessage) {
+	BinaryLogReader::Record record{ .LogLevel = Log::Level::Error, .FileName = "File.cpp", .Function = "Func", .LineNumber = 12, .Message = "Boom" };
+	auto text = BinaryLogReader::ToString(record);
+
+	ASSERT_NE(std::string::npos, text.find("[Error] File.cpp:12 (Func)"));
+	ASSERT_TRUE(text.ends_with("- Boom"));
+}
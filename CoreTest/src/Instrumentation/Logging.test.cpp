@@ -3,9 +3,16 @@
 #include "Core/Instrumentation/Logging.h"
 #include "Core/Instrumentation/ISink.h"
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 struct TestLogSink : public Log::ISink {
 	TestLogSink(Log::Filter filter)
 		: ISink(filter) {}
+	~TestLogSink() override {
+		Unsubscribe();
+	}
 
 	void Write(const Log::Entry& entry) override {
 		messages.push_back(entry);
@@ -92,4 +99,213 @@ TEST_F(LoggingTest, CustomFilter_WithNoMatch_DoesNotWrite) {
 	});
 
 	ASSERT_FALSE(DoesLog(Log::Level::Info, filter));
-}
\ No newline at end of file
+}
+
+struct AsyncLoggingTest : public testing::Test {
+	void TearDown() override {
+		Log::DisableAsync();
+	}
+};
+
+TEST_F(AsyncLoggingTest, Flush_WithManyThreads_WritesEveryEntry) {
+	TestLogSink sink({});
+	Log::EnableAsync({ .QueueCapacity = 64, .BatchSize = 16 });
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < 4; t++) {
+		threads.emplace_back([]() {
+			for (size_t i = 0; i < 1000; i++) {
+				Log::Info("Async Info");
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	Log::Flush();
+
+	ASSERT_EQ(4000u, sink.messages.size());
+	ASSERT_EQ(0u, Log::DroppedCount());
+}
+
+TEST_F(AsyncLoggingTest, Error_WithQueuedEntries_WritesQueuedEntriesFirst) {
+	TestLogSink sink({});
+	Log::EnableAsync();
+
+	Log::Info("First");
+	Log::Warn("Second");
+	Log::Error("Third");
+
+	ASSERT_EQ(3u, sink.messages.size());
+	ASSERT_EQ("First", sink.messages[0].Message);
+	ASSERT_EQ("Second", sink.messages[1].Message);
+	ASSERT_EQ("Third", sink.messages[2].Message);
+}
+
+TEST_F(AsyncLoggingTest, Flush_WhileServiceLocatorChanges_WritesEveryEntry) {
+	struct OtherService {};
+	TestLogSink sink({});
+	Log::EnableAsync({ .QueueCapacity = 64, .BatchSize = 16 });
+
+	// The writer thread publishes while this thread changes the (unsynchronized) locator
+	for (size_t i = 0; i < 1000; i++) {
+		Log::Info("Async Info");
+		if (i % 10 == 0) {
+			ServiceLocator::Get().Set<OtherService>();
+			ServiceLocator::Get().Reset<OtherService>();
+		}
+	}
+	Log::Flush();
+
+	ASSERT_EQ(1000u, sink.messages.size());
+}
+
+struct BlockingLogSink : public Log::ISink {
+	BlockingLogSink() : ISink({}) {}
+	~BlockingLogSink() override {
+		Unsubscribe();
+	}
+
+	void Write(const Log::Entry& entry) override {
+		if (!released) {
+			released = true;
+			release.get_future().wait();
+		}
+		messages.push_back(entry.Message);
+	}
+
+	std::atomic<bool> released{ false };
+	std::promise<void> release;
+	std::vector<std::string> messages;
+};
+
+TEST_F(AsyncLoggingTest, Drop_WithFullQueue_DiscardsNewEntries) {
+	BlockingLogSink sink;
+	Log::EnableAsync({ .QueueCapacity = 4, .BatchSize = 1, .Overflow = Log::OverflowPolicy::Drop });
+
+	Log::Info("Blocker");
+	while (!sink.released) {
+		std::this_thread::yield();
+	}
+	for (size_t i = 0; i < 10; i++) {
+		Log::Info(std::to_string(i));
+	}
+	sink.release.set_value();
+	Log::Flush();
+
+	ASSERT_EQ(6u, Log::DroppedCount());
+	ASSERT_EQ((std::vector<std::string>{ "Blocker", "0", "1", "2", "3" }), sink.messages);
+}
+
+TEST_F(AsyncLoggingTest, DropOldest_WithFullQueue_KeepsNewestEntries) {
+	BlockingLogSink sink;
+	Log::EnableAsync({ .QueueCapacity = 4, .BatchSize = 1, .Overflow = Log::OverflowPolicy::DropOldest });
+
+	Log::Info("Blocker");
+	while (!sink.released) {
+		std::this_thread::yield();
+	}
+	for (size_t i = 0; i < 10; i++) {
+		Log::Info(std::to_string(i));
+	}
+	sink.release.set_value();
+	Log::Flush();
+
+	ASSERT_EQ(6u, Log::DroppedCount());
+	ASSERT_EQ((std::vector<std::string>{ "Blocker", "6", "7", "8", "9" }), sink.messages);
+}
+
+TEST_F(AsyncLoggingTest, Block_WithFullQueue_WaitsForWriter) {
+	BlockingLogSink sink;
+	Log::EnableAsync({ .QueueCapacity = 4, .BatchSize = 1, .Overflow = Log::OverflowPolicy::Block });
+
+	Log::Info("Blocker");
+	while (!sink.released) {
+		std::this_thread::yield();
+	}
+	std::atomic<bool> producerDone{ false };
+	std::thread producer([&]() {
+		for (size_t i = 0; i < 10; i++) {
+			Log::Info(std::to_string(i));
+		}
+		producerDone = true;
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	EXPECT_FALSE(producerDone);
+
+	sink.release.set_value();
+	producer.join();
+	Log::Flush();
+
+	ASSERT_EQ(0u, Log::DroppedCount());
+	ASSERT_EQ((std::vector<std::string>{ "Blocker", "0", "1", "2", "3", "4", "5", "6", "7", "8", "9" }), sink.messages);
+}
+
+TEST_F(LoggingTest, FilePatternFilter_WithMatchingFile_WritesEveryMessage) {
+	auto filter = Log::Filter().WithFilePattern(std::regex(".*Logging\\.test\\.cpp"));
+	TestLogSink sink(filter);
+	Log::Info("First");
+	Log::Info("Second");
+
+	ASSERT_EQ(2u, sink.messages.size());
+}
+
+TEST_F(LoggingTest, FilePatternFilter_WithOtherFile_DoesNotWrite) {
+	// Copies of the filter share its cache
+	auto filter = Log::Filter().WithFilePattern(std::regex(".*Other\\.cpp"));
+	TestLogSink sink(filter);
+	for (size_t i = 0; i < 2; i++) {
+		Log::Info("Test Info");
+		ASSERT_TRUE(sink.messages.empty());
+	}
+
+	// Same file both times, so the second miss came from the cache
+	ASSERT_EQ(1u, filter.FilePatternEvaluations());
+}
+
+TEST_F(LoggingTest, LogMacro_WithFormatArgs_WritesFormattedMessage) {
+	TestLogSink sink(NoFilter);
+	DR_LOG_INFO("{} + {} = {}", 1, 2, 3);
+
+	ASSERT_EQ(1u, sink.messages.size());
+	ASSERT_EQ("1 + 2 = 3", sink.messages[0].Message);
+	ASSERT_EQ(Log::Level::Info, sink.messages[0].LogLevel);
+}
+
+TEST_F(LoggingTest, LogMacro_WithLevelNoSinkWants_DoesNotEvaluateArgs) {
+	TestLogSink sink(WarnFilter);
+	bool evaluated = false;
+	auto expensive = [&]() { evaluated = true; return 42; };
+
+	DR_LOG_DEBUG("{}", expensive());
+	DR_LOG_INFO("{}", expensive());
+
+	ASSERT_FALSE(evaluated);
+	ASSERT_TRUE(sink.messages.empty());
+}
+
+TEST_F(LoggingTest, IsEnabled_WithNoSinks_ReturnsFalse) {
+	ASSERT_FALSE(Log::IsEnabled(Log::Level::Error));
+	{
+		TestLogSink sink(WarnFilter);
+		ASSERT_FALSE(Log::IsEnabled(Log::Level::Info));
+		ASSERT_TRUE(Log::IsEnabled(Log::Level::Warning));
+		ASSERT_TRUE(Log::IsEnabled(Log::Level::Error));
+	}
+	ASSERT_FALSE(Log::IsEnabled(Log::Level::Warning));
+}
+
+TEST_F(AsyncLoggingTest, LogMacro_WithTemporaryStringView_FormatsCopy) {
+	TestLogSink sink({});
+	Log::EnableAsync();
+
+	{
+		std::string temporary = "temporary";
+		DR_LOG_INFO("{} {}", std::string_view(temporary), temporary.c_str());
+		temporary = "overwritten";
+	}
+	Log::Flush();
+
+	ASSERT_EQ(1u, sink.messages.size());
+	ASSERT_EQ("temporary temporary", sink.messages[0].Message);
+}
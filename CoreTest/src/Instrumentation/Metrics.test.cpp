@@ -0,0 +1,132 @@
+#include "TestCommon.h"
+
+#include "Core/Instrumentation/Metrics.h"
+#include "Core/Instrumentation/ScopedTimer.h"
+
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(Metrics, Get_WithSameName_ReturnsSameMetric) {
+	Metrics::Registry registry;
+
+	auto& first = registry.Get("Request");
+	auto& second = registry.Get("Request");
+	auto& other = registry.Get("Other");
+
+	ASSERT_EQ(&first, &second);
+	ASSERT_NE(&first, &other);
+	ASSERT_EQ("Request", first.Name());
+}
+
+TEST(Metrics, Collect_AfterRecording_ReturnsIntervalAndTotal) {
+	Metrics::Registry registry;
+	auto& metric = registry.Get("Request");
+	metric.Record(1.0);
+	metric.Record(3.0);
+
+	auto first = registry.Collect();
+	ASSERT_EQ(1u, first.Metrics.size());
+	ASSERT_EQ("Request", first.Metrics[0].Name);
+	ASSERT_EQ(2u, first.Metrics[0].Interval.Count());
+	ASSERT_EQ(2.0, first.Metrics[0].Interval.Mean());
+
+	metric.Record(5.0);
+	auto second = registry.Collect();
+	ASSERT_EQ(1u, second.Metrics[0].Interval.Count());
+	ASSERT_EQ(3u, second.Metrics[0].Total.Count());
+	ASSERT_EQ(5.0, second.Metrics[0].Total.Max());
+}
+
+TEST(Metrics, Collect_WithManyThreads_MergesEveryRecord) {
+	Metrics::Registry registry;
+	auto& metric = registry.Get("Work");
+	constexpr size_t ThreadCount = 4;
+	constexpr size_t RecordsPerThread = 10'000;
+
+	std::atomic<bool> done{ false };
+	u64 collected = 0;
+	std::thread collector([&]() {
+		while (!done) {
+			collected += registry.Collect().Metrics[0].Interval.Count();
+			std::this_thread::yield();
+		}
+	});
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < ThreadCount; t++) {
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < RecordsPerThread; i++) {
+				metric.Record(static_cast<f64>(t + 1));
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	done = true;
+	collector.join();
+	collected += registry.Collect().Metrics[0].Interval.Count();
+
+	ASSERT_EQ(ThreadCount * RecordsPerThread, collected);
+	auto total = registry.Collect().Metrics[0].Total;
+	ASSERT_EQ(ThreadCount * RecordsPerThread, total.Count());
+	ASSERT_EQ(1.0, total.Min());
+	ASSERT_EQ(4.0, total.Max());
+	ASSERT_DOUBLE_EQ(2.5, total.Mean());
+}
+
+TEST(Metrics, StartAggregator_PublishesSnapshots) {
+	Metrics::Registry registry;
+	registry.Get("Request").Record(1.0);
+
+	std::atomic<u64> recorded{ 0 };
+	registry.OnSnapshot().Subscribe([&](const Metrics::Snapshot& snapshot) {
+		recorded = snapshot.Metrics[0].Total.Count();
+	});
+	registry.StartAggregator(5ms);
+	auto end = std::chrono::steady_clock::now() + 5s;
+	while (recorded == 0 && std::chrono::steady_clock::now() < end) {
+		std::this_thread::sleep_for(1ms);
+	}
+	registry.StopAggregator();
+
+	ASSERT_EQ(1u, recorded.load());
+}
+
+TEST(Metrics, ScopedTimer_WithMetric_RecordsElapsedMicros) {
+	Metrics::Registry registry;
+	auto& metric = registry.Get("Timer");
+	{
+		ScopedTimer timer(metric);
+		std::this_thread::sleep_for(2ms);
+	}
+
+	auto snapshot = registry.Collect();
+	ASSERT_EQ(1u, snapshot.Metrics[0].Interval.Count());
+	ASSERT_GE(snapshot.Metrics[0].Interval.Min(), 2000.0);
+}
+
+TEST(Metrics, Record_AfterRegistriesDestroyed_RecordsIntoNewRegistry) {
+	// Each registry's recorders are freed with it, this thread only keeps its live ones
+	for (size_t i = 0; i < 100; i++) {
+		Metrics::Registry registry;
+		registry.Get("Request").Record(static_cast<f64>(i));
+
+		auto snapshot = registry.Collect();
+		ASSERT_EQ(1u, snapshot.Metrics[0].Interval.Count());
+		ASSERT_EQ(static_cast<f64>(i), snapshot.Metrics[0].Interval.Max());
+	}
+}
+
+TEST(Metrics, Collect_AfterThreadExits_ReturnsItsRecords) {
+	Metrics::Registry registry;
+	auto& metric = registry.Get("Work");
+	for (size_t t = 0; t < 10; t++) {
+		std::thread([&]() {
+			metric.Record(1.0);
+		}).join();
+		ASSERT_EQ(1u, registry.Collect().Metrics[0].Interval.Count());
+	}
+	ASSERT_EQ(10u, registry.Collect().Metrics[0].Total.Count());
+}
@@ -0,0 +1,121 @@
+#include "TestCommon.h"
+
+#include "Core/Instrumentation/Trace.h"
+
+#include <thread>
+
+namespace {
+	size_t CountOccurrences(const std::string& text, const std::string& pattern) {
+		size_t count = 0;
+		for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+			count++;
+		}
+		return count;
+	}
+
+	// Value of "key": number in the first event named name
+	f64 EventNumber(const std::string& json, const std::string& name, const std::string& key) {
+		auto event = json.find("\"name\": \"" + name + "\"");
+		if (event == std::string::npos) return -1.0;
+		auto value = json.find("\"" + key + "\": ", event);
+		return std::stod(json.substr(value + key.size() + 4));
+	}
+
+	void Nested() {
+		DR_TRACE_ZONE("Outer");
+		{
+			DR_TRACE_ZONE("Inner");
+		}
+	}
+}
+
+TEST(Trace, Disabled_RecordsNothing) {
+	Trace::Start();
+	Trace::Stop();
+	{
+		DR_TRACE_ZONE("WhileStopped");
+	}
+
+	ASSERT_EQ(std::string::npos, Trace::ToChromeJson().find("WhileStopped"));
+}
+
+TEST(Trace, NestedZones_ExportAsCompleteEvents) {
+	Trace::Start();
+	Nested();
+	Trace::Stop();
+
+	auto json = Trace::ToChromeJson();
+	ASSERT_EQ(1u, CountOccurrences(json, "\"name\": \"Outer\""));
+	ASSERT_EQ(1u, CountOccurrences(json, "\"name\": \"Inner\""));
+	ASSERT_NE(std::string::npos, json.find("Trace.test.cpp"));
+
+	auto outerStart = EventNumber(json, "Outer", "ts");
+	auto innerStart = EventNumber(json, "Inner", "ts");
+	ASSERT_LE(outerStart, innerStart);
+	ASSERT_LE(innerStart + EventNumber(json, "Inner", "dur"), outerStart + EventNumber(json, "Outer", "dur") + 0.001);
+}
+
+TEST(Trace, Start_DiscardsPreviousTrace) {
+	Trace::Start();
+	Nested();
+	Trace::Start();
+	Trace::Stop();
+
+	ASSERT_EQ(std::string::npos, Trace::ToChromeJson().find("Outer"));
+}
+
+TEST(Trace, Duration_MatchesWallTime) {
+	for (auto useTsc : { true, false }) {
+		Trace::Start({ .EventsPerThread = 1 << 16, .UseTsc = useTsc });
+		{
+			DR_TRACE_ZONE("Sleep");
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		Trace::Stop();
+
+		auto duration = EventNumber(Trace::ToChromeJson(), "Sleep", "dur");
+		ASSERT_GE(duration, 4500.0);
+		ASSERT_LT(duration, 500'000.0);
+	}
+}
+
+TEST(Trace, FullBuffer_KeepsNewestZones) {
+	Trace::Start({ .EventsPerThread = 8, .UseTsc = true });
+	std::thread([]() {
+		Trace::SetThreadName("Wrapping");
+		for (int i = 0; i < 100; i++) {
+			DR_TRACE_ZONE("Repeated");
+		}
+	}).join();
+	Trace::Stop();
+
+	auto json = Trace::ToChromeJson();
+	ASSERT_NE(std::string::npos, json.find("\"name\": \"Wrapping\""));
+	ASSERT_EQ(4u, CountOccurrences(json, "\"name\": \"Repeated\""));
+}
+
+TEST(Trace, Threads_GetTheirOwnTracks) {
+	Trace::Start();
+	std::thread first([]() { DR_TRACE_ZONE("First"); });
+	std::thread second([]() { DR_TRACE_ZONE("Second"); });
+	first.join();
+	second.join();
+	Trace::Stop();
+
+	auto json = Trace::ToChromeJson();
+	ASSERT_NE(EventNumber(json, "First", "tid"), EventNumber(json, "Second", "tid"));
+}
+
+TEST(Trace, ExitedThread_KeepsEventsWhileOtherThreadsStart) {
+	Trace::Start();
+	std::thread([]() { DR_TRACE_ZONE("Exited"); }).join();
+	// Creating these buffers reclaims exited threads' buffers, but not ones in the current trace
+	for (int i = 0; i < 4; i++) {
+		std::thread([]() { DR_TRACE_ZONE("Later"); }).join();
+	}
+	Trace::Stop();
+
+	auto json = Trace::ToChromeJson();
+	ASSERT_EQ(1u, CountOccurrences(json, "\"name\": \"Exited\""));
+	ASSERT_EQ(4u, CountOccurrences(json, "\"name\": \"Later\""));
+}
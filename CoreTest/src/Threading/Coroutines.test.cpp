@@ -0,0 +1,114 @@
+#include "TestCommon.h"
+#include "Core/Threading/Coroutines.h"
+
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+	Threading::Task<int> Double(Threading::Scheduler& scheduler, int value) {
+		co_await scheduler.Schedule();
+		co_return value * 2;
+	}
+
+	Threading::Task<int> Delayed(Threading::Scheduler& scheduler, int value, std::chrono::milliseconds delay) {
+		co_await scheduler.Schedule();
+		std::this_thread::sleep_for(delay);
+		co_return value;
+	}
+
+	Threading::Task<int> Throws(Threading::Scheduler& scheduler) {
+		co_await scheduler.Schedule();
+		throw std::runtime_error("failed");
+	}
+
+	Threading::Task<void> Increment(Threading::Scheduler& scheduler, std::atomic<int>& counter) {
+		co_await scheduler.Schedule();
+		counter++;
+	}
+}
+
+struct CoroutineTest : public testing::Test {
+	Threading::ThreadPool pool{ 4 };
+	Threading::Scheduler scheduler{ pool };
+};
+
+TEST_F(CoroutineTest, SyncWait_WithImmediateTask_ReturnsValue) {
+	auto task = []() -> Threading::Task<int> { co_return 42; }();
+	ASSERT_EQ(Threading::SyncWait(std::move(task)), 42);
+}
+
+TEST_F(CoroutineTest, SyncWait_WithScheduledTask_ReturnsValue) {
+	ASSERT_EQ(Threading::SyncWait(Double(scheduler, 21)), 42);
+}
+
+TEST_F(CoroutineTest, SyncWait_WithThrowingTask_Rethrows) {
+	ASSERT_THROW(Threading::SyncWait(Throws(scheduler)), std::runtime_error);
+}
+
+TEST_F(CoroutineTest, CoAwait_ChainedTasks_PassesResults) {
+	auto chain = [](Threading::Scheduler& s) -> Threading::Task<int> {
+		auto first = co_await Double(s, 1);
+		auto second = co_await Double(s, first);
+		co_return second;
+	};
+	ASSERT_EQ(Threading::SyncWait(chain(scheduler)), 4);
+}
+
+TEST_F(CoroutineTest, WhenAll_WithManyTasks_ReturnsResultsInOrder) {
+	std::vector<Threading::Task<int>> tasks;
+	for (int i = 0; i < 1000; i++) {
+		tasks.push_back(Double(scheduler, i));
+	}
+
+	auto results = Threading::SyncWait(Threading::WhenAll(std::move(tasks)));
+	ASSERT_EQ(results.size(), 1000);
+	for (int i = 0; i < 1000; i++) {
+		ASSERT_EQ(results[i], i * 2);
+	}
+}
+
+TEST_F(CoroutineTest, WhenAll_WithVoidTasks_RunsAllTasks) {
+	std::atomic<int> counter{ 0 };
+	std::vector<Threading::Task<void>> tasks;
+	for (int i = 0; i < 100; i++) {
+		tasks.push_back(Increment(scheduler, counter));
+	}
+
+	Threading::SyncWait(Threading::WhenAll(std::move(tasks)));
+	ASSERT_EQ(counter, 100);
+}
+
+TEST_F(CoroutineTest, WhenAll_WithNoTasks_ReturnsEmpty) {
+	auto results = Threading::SyncWait(Threading::WhenAll(std::vector<Threading::Task<int>>{}));
+	ASSERT_TRUE(results.empty());
+}
+
+TEST_F(CoroutineTest, WhenAll_WithThrowingTask_Rethrows) {
+	std::vector<Threading::Task<int>> tasks;
+	tasks.push_back(Double(scheduler, 1));
+	tasks.push_back(Throws(scheduler));
+	ASSERT_THROW(Threading::SyncWait(Threading::WhenAll(std::move(tasks))), std::runtime_error);
+}
+
+TEST_F(CoroutineTest, WhenAny_WithFastAndSlowTasks_ReturnsFastest) {
+	std::vector<Threading::Task<int>> tasks;
+	tasks.push_back(Delayed(scheduler, 1, 200ms));
+	tasks.push_back(Delayed(scheduler, 2, 0ms));
+
+	auto result = Threading::SyncWait(Threading::WhenAny(std::move(tasks)));
+	ASSERT_EQ(result.Index, 1);
+	ASSERT_EQ(result.Value, 2);
+}
+
+TEST_F(CoroutineTest, Spawn_WithTask_RunsOnPool) {
+	std::atomic<int> counter{ 0 };
+	scheduler.Spawn(Increment(scheduler, counter));
+	for (int i = 0; i < 100 && counter == 0; i++) {
+		std::this_thread::sleep_for(1ms);
+	}
+	ASSERT_EQ(counter, 1);
+}
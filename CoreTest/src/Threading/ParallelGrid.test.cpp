@@ -0,0 +1,91 @@
+#include "TestCommon.h"
+#include "Core/Threading/ParallelGrid.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <set>
+
+TEST(ParallelForEach, ParallelForEach_WithRowColMax_VisitsEveryPointOnce) {
+	Threading::ThreadPool pool{ 4 };
+	std::vector<std::atomic<u32>> visits(100 * 200);
+
+	ParallelForEach(pool, RowCol{ 99, 199 }, [&](RowCol rc) {
+		visits[rc.Row * 200 + rc.Col]++;
+	});
+
+	for (const auto& count : visits) {
+		ASSERT_EQ(1u, count.load());
+	}
+}
+
+TEST(ParallelForEach, ParallelForEach_WithVec3_MatchesSerialForEach) {
+	Threading::ThreadPool pool{ 4 };
+	Vec3<s64> min{ -3, -5, 2 };
+	Vec3<s64> max{ 20, 40, 9 };
+
+	std::set<Vec3<s64>> expected;
+	Constexpr::ForEach(min, max, [&](Vec3<s64> pos) { expected.insert(pos); });
+
+	std::mutex mutex;
+	std::set<Vec3<s64>> actual;
+	ParallelForEach(pool, min, max, [&](Vec3<s64> pos) {
+		std::lock_guard lock(mutex);
+		actual.insert(pos);
+	}, 64);
+
+	ASSERT_EQ(expected, actual);
+}
+
+TEST(ParallelForEach, ParallelForEach_WithEmptyRange_DoesNothing) {
+	Threading::ThreadPool pool{ 2 };
+	bool called = false;
+	ParallelForEach(pool, Vec2<s32>{ 5, 5 }, Vec2<s32>{ 4, 10 }, [&](Vec2<s32>) { called = true; });
+	ASSERT_FALSE(called);
+}
+
+TEST(ParallelForEach, ParallelForEach_WithThrowingFunc_Rethrows) {
+	Threading::ThreadPool pool{ 4 };
+	auto run = [&]() {
+		ParallelForEach(pool, RowCol{ 0, 0 }, RowCol{ 500, 500 }, [](RowCol rc) {
+			if (rc.Row == 250 && rc.Col == 250) throw std::runtime_error("boom");
+		});
+	};
+	ASSERT_THROW(run(), std::runtime_error);
+}
+
+TEST(ParallelReduce, ParallelReduce_WithVec4_MatchesSerialSum) {
+	Threading::ThreadPool pool{ 4 };
+	Vec4<s32> min{ 0, 0, 0, 0 };
+	Vec4<s32> max{ 9, 19, 4, 30 };
+
+	s64 expected = 0;
+	Constexpr::ForEach(min, max, [&](Vec4<s32> pos) { expected += pos.X * 1000 + pos.Y * 100 + pos.Z * 10 + pos.W; });
+
+	auto actual = ParallelReduce(pool, min, max, s64(0),
+		[](Vec4<s32> pos) { return s64(pos.X * 1000 + pos.Y * 100 + pos.Z * 10 + pos.W); },
+		std::plus<s64>{}, 100);
+
+	ASSERT_EQ(expected, actual);
+}
+
+TEST(ParallelReduce, ParallelReduce_WithNonCommutativeReduce_KeepsSerialOrder) {
+	Vec2<s32> min{ 0, 0 };
+	Vec2<s32> max{ 7, 5 };
+
+	std::string expected;
+	Constexpr::ForEach(min, max, [&](Vec2<s32> pos) { expected += std::to_string(pos.X) + std::to_string(pos.Y); });
+
+	for (size_t threads : { 1u, 3u, 8u }) {
+		Threading::ThreadPool pool{ threads };
+		auto actual = ParallelReduce(pool, min, max, std::string{},
+			[](Vec2<s32> pos) { return std::to_string(pos.X) + std::to_string(pos.Y); },
+			[](std::string lhs, const std::string& rhs) { return lhs + rhs; }, 5);
+		ASSERT_EQ(expected, actual);
+	}
+}
+
+TEST(ParallelReduce, ParallelReduce_WithEmptyRange_ReturnsIdentity) {
+	auto result = ParallelReduce(RowCol{ 3, 0 }, RowCol{ 2, 0 }, 42, [](RowCol) { return 1; }, std::plus<int>{});
+	ASSERT_EQ(42, result);
+}
@@ -0,0 +1,54 @@
+#include "TestCommon.h"
+#include "Core/Threading/SpscQueue.h"
+
+#include <string>
+#include <thread>
+
+TEST(SpscQueue, Constructor_WithOddCapacity_RoundsUpToPowerOfTwo) {
+	Threading::SpscQueue<int> queue(5);
+	ASSERT_EQ(queue.Capacity(), 8);
+}
+
+TEST(SpscQueue, TryPush_WhenFull_ReturnsFalse) {
+	Threading::SpscQueue<int> queue(4);
+	for (int i = 0; i < 4; i++) {
+		ASSERT_TRUE(queue.TryPush(i));
+	}
+	ASSERT_FALSE(queue.TryPush(4));
+
+	ASSERT_EQ(queue.TryPop(), 0);
+	ASSERT_TRUE(queue.TryPush(4));
+}
+
+TEST(SpscQueue, TryPop_WhenEmpty_ReturnsNullopt) {
+	Threading::SpscQueue<std::string> queue(4);
+	ASSERT_TRUE(queue.Empty());
+	ASSERT_FALSE(queue.TryPop().has_value());
+
+	queue.TryPush(std::string("value"));
+	ASSERT_EQ(queue.TryPop(), "value");
+	ASSERT_TRUE(queue.Empty());
+}
+
+TEST(SpscQueue, TryPop_AcrossThreads_ReceivesValuesInOrder) {
+	const size_t count = 100'000;
+	Threading::SpscQueue<size_t> queue(64);
+
+	std::jthread producer([&]() {
+		for (size_t i = 0; i < count; i++) {
+			while (!queue.TryPush(i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	for (size_t expected = 0; expected < count;) {
+		if (auto value = queue.TryPop()) {
+			ASSERT_EQ(*value, expected);
+			expected++;
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+}
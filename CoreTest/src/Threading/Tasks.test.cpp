@@ -5,6 +5,8 @@
 #include <chrono>
 #include <array>
 #include <functional>
+#include <numeric>
+#include <ranges>
 
 using namespace std::chrono_literals;
 
@@ -55,6 +57,23 @@ TEST(WhenAll, WhenAll_WithProgressCallback_CallsCallback) {
 	ASSERT_EQ(callCount, 1);
 }
 
+TEST(WhenAll, WhenAll_WithProgressCallback_ReportsEveryTaskBeforeCompleting) {
+	constexpr size_t TaskCount = 16;
+	size_t callCount = 0;
+	size_t lastFinished = 0;
+	auto OnProgress = [&](size_t finished, size_t, double) {
+		// Slow enough that other tasks finish while a report is in progress
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		callCount++;
+		lastFinished = finished;
+	};
+
+	std::vector<std::function<void()>> tasks(TaskCount, []() {});
+	WhenAll(std::move(tasks), OnProgress).get();
+	ASSERT_EQ(callCount, TaskCount);
+	ASSERT_EQ(lastFinished, TaskCount);
+}
+
 std::function<size_t()> MakeResultTask(size_t result, size_t delayTime) {
 	return [result, delayTime]() {
 		std::this_thread::sleep_for(std::chrono::milliseconds(delayTime));
@@ -79,4 +98,156 @@ TEST(WhenAll, WhenAll_WithResult_ReturnsVectorOfResults) {
 	future.wait();
 	auto results = future.get();
 	ASSERT_THAT(results, ::testing::UnorderedElementsAreArray(expectedResults));
-}
\ No newline at end of file
+}
+
+TEST(WhenAll, WhenAll_WithResult_PreservesTaskOrder) {
+	std::vector<std::function<size_t()>> tasks{};
+	std::vector<size_t> expectedResults{};
+	for (size_t i = 0ull; i < 50; i++) {
+		tasks.emplace_back(MakeResultTask(i, (50 - i) % 5));
+		expectedResults.emplace_back(i);
+	}
+	auto results = WhenAll(tasks).get();
+	ASSERT_THAT(results, ::testing::ElementsAreArray(expectedResults));
+}
+
+TEST(ParallelMap, ParallelMap_WithEmptyRange_ReturnsEmptyVector) {
+	std::vector<int> input{};
+	auto results = ParallelMap(input, [](int i) { return i * 2; });
+	ASSERT_TRUE(results.empty());
+}
+
+TEST(ParallelMap, ParallelMap_WithManyItems_PreservesOrder) {
+	std::vector<size_t> input(100'000);
+	std::iota(input.begin(), input.end(), 0);
+
+	auto results = ParallelMap(input, [](size_t i) { return i * 2; }, 64);
+	ASSERT_EQ(results.size(), input.size());
+	for (size_t i = 0; i < input.size(); i++) {
+		ASSERT_EQ(results[i], i * 2);
+	}
+}
+
+TEST(ParallelMap, ParallelMap_WithBoolResult_PreservesOrder) {
+	auto results = ParallelMap(std::views::iota(0, 1000), [](int i) { return i % 3 == 0; }, 7);
+	ASSERT_EQ(results.size(), 1000);
+	for (int i = 0; i < 1000; i++) {
+		ASSERT_EQ(results[i], i % 3 == 0);
+	}
+}
+
+TEST(ParallelMap, ParallelMap_WithThrowingFunc_Rethrows) {
+	std::vector<int> input(1000, 1);
+	input[500] = 0;
+	auto divide = [](int i) {
+		if (i == 0) throw std::runtime_error("divide by zero");
+		return 10 / i;
+	};
+	ASSERT_THROW(ParallelMap(input, divide, 10), std::runtime_error);
+}
+
+TEST(ParallelMap, ParallelMap_FromInsidePoolTask_DoesNotDeadlock) {
+	Threading::ThreadPool pool(1);
+	auto future = pool.Submit([&pool]() {
+		return ParallelMap(pool, std::views::iota(0, 100), [](int i) { return i; }, 1).back();
+	});
+	ASSERT_EQ(future.get(), 99);
+}
+
+TEST(WhenAllCancellation, WhenAll_WithOptionsAndNoFailures_ReturnsResults) {
+	std::vector<std::function<size_t()>> tasks{ MakeResultTask(1, 0), MakeResultTask(2, 0) };
+	auto results = WhenAll(tasks, Threading::WhenAllOptions{}).get();
+	ASSERT_THAT(results, ::testing::ElementsAre(1, 2));
+}
+
+TEST(WhenAllCancellation, WhenAll_WithFailingTasks_ThrowsAggregateException) {
+	Threading::ThreadPool pool(1);
+	std::vector<std::function<void()>> tasks{
+		[]() { throw std::runtime_error("first"); },
+		[]() { throw std::logic_error("second"); }
+	};
+
+	try {
+		WhenAll(pool, tasks, Threading::WhenAllOptions{ .CancelOnFailure = false }).get();
+		FAIL() << "Expected AggregateException";
+	}
+	catch (const Threading::AggregateException& e) {
+		ASSERT_EQ(e.Exceptions.size(), 2);
+	}
+}
+
+TEST(WhenAllCancellation, WhenAll_WithFailure_SkipsRemainingTasks) {
+	Threading::ThreadPool pool(1);
+	std::atomic<bool> failed{ false };
+	std::atomic<size_t> ranCount{ 0 };
+	// The pool's run order isn't specified, so whichever task runs first is the one that fails
+	std::vector<std::function<void()>> tasks;
+	for (size_t i = 0; i < 101; i++) {
+		tasks.emplace_back([&failed, &ranCount]() {
+			if (!failed.exchange(true)) throw std::runtime_error("failed");
+			ranCount++;
+		});
+	}
+
+	ASSERT_THROW(WhenAll(pool, tasks, Threading::WhenAllOptions{}).get(), Threading::AggregateException);
+	ASSERT_EQ(ranCount, 0);
+}
+
+TEST(WhenAllCancellation, WhenAll_WithFailure_StopsRunningTasks) {
+	Threading::ThreadPool pool(2);
+	std::vector<std::function<void(std::stop_token)>> tasks{
+		[](std::stop_token token) {
+			while (!token.stop_requested()) {
+				std::this_thread::sleep_for(1ms);
+			}
+		},
+		[](std::stop_token) {
+			std::this_thread::sleep_for(10ms);
+			throw std::runtime_error("failed");
+		}
+	};
+
+	ASSERT_THROW(WhenAll(pool, tasks, Threading::WhenAllOptions{}).get(), Threading::AggregateException);
+}
+
+TEST(WhenAllCancellation, WhenAll_WithStopRequested_ThrowsOperationCancelled) {
+	Threading::ThreadPool pool(1);
+	std::stop_source source;
+	std::vector<std::function<void(std::stop_token)>> tasks{
+		[](std::stop_token token) {
+			while (!token.stop_requested()) {
+				std::this_thread::sleep_for(1ms);
+			}
+		}
+	};
+
+	auto future = WhenAll(pool, tasks, Threading::WhenAllOptions{ .StopToken = source.get_token() });
+	source.request_stop();
+	try {
+		future.get();
+		FAIL() << "Expected OperationCancelled";
+	}
+	catch (const Threading::OperationCancelled& e) {
+		ASSERT_EQ(e.Reason, Threading::CancelReason::Requested);
+	}
+}
+
+TEST(WhenAllCancellation, WhenAll_WithDeadline_ThrowsOperationCancelled) {
+	Threading::ThreadPool pool(1);
+	std::vector<std::function<void(std::stop_token)>> tasks{
+		[](std::stop_token token) {
+			while (!token.stop_requested()) {
+				std::this_thread::sleep_for(1ms);
+			}
+		}
+	};
+
+	auto future = WhenAll(pool, tasks, Threading::WhenAllOptions{ .Deadline = std::chrono::steady_clock::now() + 20ms });
+	try {
+		future.get();
+		FAIL() << "Expected OperationCancelled";
+	}
+	catch (const Threading::OperationCancelled& e) {
+		ASSERT_EQ(e.Reason, Threading::CancelReason::Deadline);
+	}
+}
@@ -0,0 +1,64 @@
+#include "TestCommon.h"
+#include "Core/Threading/ThreadPool.h"
+#include "Core/Threading/Tasks.h"
+
+#include <atomic>
+#include <latch>
+
+TEST(ThreadPool, Constructor_WithZeroThreads_CreatesOneThread) {
+	Threading::ThreadPool pool(0);
+	ASSERT_EQ(pool.ThreadCount(), 1);
+}
+
+TEST(ThreadPool, Submit_WithResult_ReturnsResult) {
+	Threading::ThreadPool pool(2);
+	auto future = pool.Submit([]() { return 42; });
+	ASSERT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPool, Post_WithManyTasks_RunsAllTasks) {
+	const size_t taskCount = 10'000;
+	std::atomic<size_t> count{ 0 };
+	std::latch done(taskCount);
+	{
+		Threading::ThreadPool pool(4);
+		for (size_t i = 0; i < taskCount; i++) {
+			pool.Post([&]() { count++; done.count_down(); });
+		}
+		done.wait();
+	}
+	ASSERT_EQ(count, taskCount);
+}
+
+TEST(ThreadPool, Post_FromWorker_RunsNestedTask) {
+	Threading::ThreadPool pool(2);
+	std::promise<bool> nested;
+	pool.Post([&]() {
+		pool.Post([&]() { nested.set_value(pool.IsWorkerThread()); });
+	});
+	ASSERT_TRUE(nested.get_future().get());
+	ASSERT_FALSE(pool.IsWorkerThread());
+}
+
+TEST(ThreadPool, WhenAll_WithPool_RunsAllTasks) {
+	Threading::ThreadPool pool(3);
+	std::vector<std::function<size_t()>> tasks;
+	for (size_t i = 0; i < 1000; i++) {
+		tasks.emplace_back([i]() { return i; });
+	}
+
+	auto results = WhenAll(pool, tasks).get();
+	ASSERT_EQ(results.size(), 1000);
+}
+
+TEST(ThreadPool, WhenAll_WithThrowingTask_RethrowsFromGet) {
+	Threading::ThreadPool pool(2);
+	std::vector<std::function<void()>> tasks{
+		[]() {},
+		[]() { throw std::runtime_error("failed"); },
+		[]() {}
+	};
+
+	auto future = WhenAll(pool, tasks);
+	ASSERT_THROW(future.get(), std::runtime_error);
+}
@@ -0,0 +1,37 @@
+#include "Core/Instrumentation/LogWriter/BinaryLogReader.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Renders binary log segments as text.
+// Usage: LogDecoder <segment.drlog>...
+//        LogDecoder <directory> [baseName]
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "Usage: %s <segment.drlog>... | <directory> [baseName]\n", argv[0]);
+		return 1;
+	}
+
+	std::vector<std::string> segments;
+	if (std::filesystem::is_directory(argv[1])) {
+		segments = BinaryLogReader::FindSegments(argv[1], argc > 2 ? argv[2] : "log");
+	}
+	else {
+		segments.assign(argv + 1, argv + argc);
+	}
+
+	for (const auto& segment : segments) {
+		try {
+			for (const auto& record : BinaryLogReader::ReadSegment(segment)) {
+				std::printf("%s\n", BinaryLogReader::ToString(record).c_str());
+			}
+		}
+		catch (const char* error) {
+			std::fprintf(stderr, "%s: %s\n", segment.c_str(), error);
+			return 1;
+		}
+	}
+	return 0;
+}